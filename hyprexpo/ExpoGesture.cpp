@@ -9,17 +9,23 @@
 void CExpoGesture::begin(const ITrackpadGesture::STrackpadGestureBegin& e) {
     ITrackpadGesture::begin(e);
 
-    if (!g_pOverview)
-        g_pOverview = std::make_unique<COverview>(Desktop::focusState()->monitor()->m_activeWorkspace, true, 0);
+    const auto PMONITOR = Desktop::focusState()->monitor();
+    if (!PMONITOR)
+        return;
+
+    m_monitorID = PMONITOR->m_id;
+
+    if (!overviewFor(m_monitorID))
+        g_overviews[m_monitorID] = std::make_unique<COverview>(PMONITOR->m_activeWorkspace, true, 0);
 }
 
 void CExpoGesture::update(const ITrackpadGesture::STrackpadGestureUpdate& e) {
 
-    if (g_pOverview)
-        g_pOverview->onSwipeUpdate(e.swipe->delta);
+    if (const auto POVERVIEW = overviewFor(m_monitorID); POVERVIEW)
+        POVERVIEW->onSwipeUpdate(e.swipe->delta);
 }
 
 void CExpoGesture::end(const ITrackpadGesture::STrackpadGestureEnd& e) {
-    if (g_pOverview)
-        g_pOverview->onSwipeEnd();
+    if (const auto POVERVIEW = overviewFor(m_monitorID); POVERVIEW)
+        POVERVIEW->onSwipeEnd();
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <hyprland/src/managers/input/trackpad/gestures/ITrackpadGesture.hpp>
+#include <hyprland/src/SharedDefs.hpp>
 
 class CExpoGesture : public ITrackpadGesture {
   public:
@@ -10,4 +11,8 @@ class CExpoGesture : public ITrackpadGesture {
     virtual void begin(const ITrackpadGesture::STrackpadGestureBegin& e);
     virtual void update(const ITrackpadGesture::STrackpadGestureUpdate& e);
     virtual void end(const ITrackpadGesture::STrackpadGestureEnd& e);
+
+  private:
+    // the monitor the swipe started on, it keeps driving that overview
+    MONITORID m_monitorID = -1;
 };
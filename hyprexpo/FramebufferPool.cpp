@@ -0,0 +1,188 @@
+#include "FramebufferPool.hpp"
+#include "overview.hpp"
+#include "TileCompositor.hpp"
+#include "globals.hpp"
+
+#include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/helpers/Monitor.hpp>
+#include <hyprland/src/render/Renderer.hpp>
+#include <hyprland/src/helpers/Format.hpp>
+
+CFramebufferPool::~CFramebufferPool() {
+    g_pHyprRenderer->makeEGLCurrent();
+    m_free.clear();
+}
+
+SP<CFramebuffer> CFramebufferPool::acquire(const Vector2D& size, uint32_t format) {
+    const SKey KEY{size, format};
+
+    for (auto it = m_free.begin(); it != m_free.end(); ++it) {
+        if (!(it->key == KEY))
+            continue;
+
+        auto fb = it->fb;
+        m_free.erase(it);
+        return fb;
+    }
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    return allocate(KEY);
+}
+
+SP<CFramebuffer> CFramebufferPool::allocate(const SKey& key) {
+    auto fb = makeShared<CFramebuffer>();
+    fb->alloc(key.size.x, key.size.y, key.format);
+
+    std::erase_if(m_allocated, [](const auto& e) { return e.expired(); });
+    m_allocated.emplace_back(fb);
+
+    return fb;
+}
+
+static size_t fbBytes(const SP<CFramebuffer>& fb) {
+    if (!fb || !fb->isAllocated())
+        return 0;
+
+    const auto FORMAT = NFormatUtils::getPixelFormatFromDRM(fb->m_drmFormat);
+
+    return (size_t)fb->m_size.x * (size_t)fb->m_size.y * (FORMAT ? FORMAT->bytesPerBlock : 4);
+}
+
+size_t CFramebufferPool::bytesAllocated() {
+    size_t bytes = 0;
+    for (auto const& e : m_allocated) {
+        bytes += fbBytes(e.lock());
+    }
+    return bytes;
+}
+
+size_t CFramebufferPool::bytesPooled() {
+    size_t bytes = 0;
+    for (auto const& e : m_free) {
+        bytes += fbBytes(e.fb);
+    }
+    return bytes;
+}
+
+void CFramebufferPool::release(SP<CFramebuffer> fb) {
+    if (!fb || !fb->isAllocated())
+        return;
+
+    // whatever mip chain it had won't match what's rendered into it next
+    if (const auto TEX = fb->getTexture(); TEX)
+        TEX->m_minFilter = GL_LINEAR;
+
+    m_free.emplace_back(SPooledFB{SKey{fb->m_size, fb->m_drmFormat}, fb});
+}
+
+void CFramebufferPool::resize(SP<CFramebuffer>& fb, const Vector2D& size, uint32_t format) {
+    if (fb && fb->isAllocated() && fb->m_size == size && fb->m_drmFormat == format)
+        return;
+
+    release(fb);
+    fb = acquire(size, format);
+}
+
+std::vector<std::pair<CFramebufferPool::SKey, size_t>> CFramebufferPool::demandFor(PHLMONITOR pMonitor) {
+    if (!pMonitor || !pMonitor->m_output || pMonitor->m_pixelSize.x <= 0 || pMonitor->m_pixelSize.y <= 0)
+        return {};
+
+    // however many workspaces there are, only the pages around the current one hold buffers
+    const auto   GRID   = COverview::gridConfig();
+    const auto   NATIVE = pMonitor->m_output->state->state().drmFormat;
+    const auto   FORMAT = COverview::thumbnailFormatFor(pMonitor);
+    const size_t TILES  = GRID.tilesPerPage() * GRID.residentPages();
+    const SKey   FULL{pMonitor->m_pixelSize, NATIVE};
+    const SKey   THUMB{COverview::thumbnailSizeFor(pMonitor, GRID), FORMAT};
+    const SKey   ATLAS{COverview::atlasSizeFor(pMonitor, GRID), FORMAT};
+
+    // everything one session holds at once
+    std::vector<std::pair<SKey, size_t>> demand;
+
+    // the same key twice, like scratch and a full size tile, just needs more of them
+    auto add = [&demand](const SKey& key, size_t count) {
+        auto it = std::ranges::find_if(demand, [&key](const auto& e) { return e.first == key; });
+        if (it == demand.end())
+            demand.emplace_back(key, count);
+        else
+            it->second += count;
+    };
+
+    // surface tiles don't render offscreen at all
+    if (!COverview::surfaceTilesConfigured()) {
+        if (ATLAS.size == Vector2D{})
+            add(FULL, TILES);
+        else {
+            // the tile we zoom out of and the scratch buffer are full size, both in the monitor's own format
+            add(FULL, 2);
+
+            // thumbnails share the atlas, or get an fb each once the tile shader turned out unusable. Asking
+            // ready() here would compile it, possibly without a current context.
+            if (!g_pTileCompositor || !g_pTileCompositor->failed())
+                add(ATLAS, 1);
+            else
+                add(THUMB, TILES);
+        }
+    }
+
+    // swish keeps every tile of its single page at full size. Only one overview is open per monitor, so
+    // it takes whichever is more of those, not both.
+    if (m_swishUsed) {
+        auto it = std::ranges::find_if(demand, [&FULL](const auto& e) { return e.first == FULL; });
+        if (it == demand.end())
+            demand.emplace_back(FULL, GRID.tilesPerPage());
+        else
+            it->second = std::max<size_t>(it->second, GRID.tilesPerPage());
+    }
+
+    return demand;
+}
+
+void CFramebufferPool::onSwishOpened() {
+    m_swishUsed = true;
+}
+
+size_t CFramebufferPool::countFree(const SKey& key) {
+    return std::ranges::count_if(m_free, [&key](const auto& e) { return e.key == key; });
+}
+
+void CFramebufferPool::prewarm(PHLMONITOR pMonitor) {
+    const auto DEMAND = demandFor(pMonitor);
+
+    if (DEMAND.empty())
+        return;
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    for (const auto& [key, count] : DEMAND) {
+        for (size_t i = countFree(key); i < count; ++i) {
+            m_free.emplace_back(SPooledFB{key, allocate(key)});
+        }
+    }
+}
+
+void CFramebufferPool::trim() {
+    std::vector<std::pair<SKey, size_t>> budget;
+
+    for (auto const& m : g_pCompositor->m_monitors) {
+        for (const auto& [key, count] : demandFor(m)) {
+            auto it = std::ranges::find_if(budget, [&key](const auto& e) { return e.first == key; });
+            if (it == budget.end())
+                budget.emplace_back(key, count);
+            else
+                it->second += count;
+        }
+    }
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    std::erase_if(m_free, [&budget](const auto& e) {
+        auto it = std::ranges::find_if(budget, [&e](const auto& b) { return b.first == e.key; });
+        if (it == budget.end() || it->second == 0)
+            return true;
+
+        it->second--;
+        return false;
+    });
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#define WLR_USE_UNSTABLE
+
+#include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <hyprland/src/render/Framebuffer.hpp>
+#include <vector>
+
+// Framebuffers outlive overview sessions, so opening one doesn't have to
+// allocate the whole grid again.
+class CFramebufferPool {
+  public:
+    CFramebufferPool() = default;
+    ~CFramebufferPool();
+
+    // an allocated fb of this size and format, pooled if we have one
+    SP<CFramebuffer> acquire(const Vector2D& size, uint32_t format);
+    void             release(SP<CFramebuffer> fb);
+    // swaps fb for a pooled one if it doesn't match size and format
+    void             resize(SP<CFramebuffer>& fb, const Vector2D& size, uint32_t format);
+
+    // allocate everything an overview on this monitor will ask for
+    void prewarm(PHLMONITOR pMonitor);
+    // drop pooled fbs beyond what the current monitors can use
+    void trim();
+    // from now on also keep what a swish session needs
+    void onSwishOpened();
+
+    // memory of every fb we handed out that's still alive, and of the idle ones
+    size_t bytesAllocated();
+    size_t bytesPooled();
+
+  private:
+    struct SKey {
+        Vector2D size;
+        uint32_t format = 0;
+
+        bool     operator==(const SKey& other) const {
+            return size == other.size && format == other.format;
+        }
+    };
+
+    struct SPooledFB {
+        SKey             key;
+        SP<CFramebuffer> fb;
+    };
+
+    std::vector<std::pair<SKey, size_t>> demandFor(PHLMONITOR pMonitor);
+    size_t                               countFree(const SKey& key);
+
+    SP<CFramebuffer>                     allocate(const SKey& key);
+
+    std::vector<SPooledFB>               m_free;
+    std::vector<WP<CFramebuffer>>        m_allocated;
+    bool                                 m_swishUsed = false;
+};
+
+inline std::unique_ptr<CFramebufferPool> g_pFramebufferPool;
@@ -0,0 +1,58 @@
+#include "GridLayout.hpp"
+
+#include <hyprland/src/helpers/Monitor.hpp>
+#include <algorithm>
+
+void CGridLayout::update(PHLMONITOR pMonitor, int columns, int rows, size_t tiles, int currentPage, const Vector2D& origin, const Vector2D& tileSize, double gap) {
+    m_columns      = std::max(columns, 1);
+    m_rows         = std::max(rows, 1);
+    m_tilesPerPage = m_columns * m_rows;
+    m_currentPage  = currentPage;
+    m_origin       = origin / pMonitor->m_scale;
+    m_pitch        = tileSize + Vector2D{gap, gap};
+    m_gap          = gap;
+
+    m_tiles.resize(tiles);
+
+    for (size_t id = 0; id < tiles; ++id) {
+        const int LOCAL  = id % m_tilesPerPage;
+        const int COLUMN = ((int)id / m_tilesPerPage - currentPage) * m_columns + LOCAL % m_columns;
+        const int ROW    = LOCAL / m_columns;
+
+        auto&     tile = m_tiles[id];
+        tile.logical   = CBox{m_origin + Vector2D{COLUMN, ROW} * m_pitch, tileSize};
+        tile.pixel     = tile.logical.copy().scale(pMonitor->m_scale).round();
+    }
+}
+
+CBox CGridLayout::logicalBox(int id) const {
+    if (id < 0 || id >= (int)m_tiles.size())
+        return {};
+
+    return m_tiles[id].logical;
+}
+
+CBox CGridLayout::pixelBox(int id) const {
+    if (id < 0 || id >= (int)m_tiles.size())
+        return {};
+
+    return m_tiles[id].pixel;
+}
+
+int CGridLayout::tileAt(const Vector2D& posLocal) const {
+    if (m_tiles.empty())
+        return -1;
+
+    const int FIRST = std::min<int>(m_currentPage * m_tilesPerPage, m_tiles.size() - 1);
+
+    // a collapsed grid, mid animation, has nothing to point at
+    if (m_pitch.x <= 0 || m_pitch.y <= 0)
+        return FIRST;
+
+    // cells are a pitch wide with their tile in the middle
+    const Vector2D CELL   = ((posLocal - m_origin + Vector2D{m_gap, m_gap} / 2.0) / m_pitch).floor();
+    const int      COLUMN = std::clamp<double>(CELL.x, 0, m_columns - 1);
+    const int      ROW    = std::clamp<double>(CELL.y, 0, m_rows - 1);
+
+    return std::min<int>(FIRST + COLUMN + ROW * m_columns, m_tiles.size() - 1);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#define WLR_USE_UNSTABLE
+
+#include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <hyprland/src/helpers/math/Math.hpp>
+#include <vector>
+
+// Where every overview tile is for one animation step, both in monitor-local logical coordinates
+// and in monitor pixels. Pages continue to the right of each other a gap apart, so the whole grid
+// shares one column and row pitch and finding the tile under a point is a division.
+class CGridLayout {
+  public:
+    // tileSize and gap are logical, origin is where the current page's first tile starts, in pixels
+    void update(PHLMONITOR pMonitor, int columns, int rows, size_t tiles, int currentPage, const Vector2D& origin, const Vector2D& tileSize, double gap);
+
+    CBox logicalBox(int id) const;
+    // logicalBox scaled to the monitor and rounded, what gets drawn and damaged
+    CBox pixelBox(int id) const;
+    // the tile of the current page whose cell holds posLocal. Gaps are split between their neighbours
+    // and points off the grid go to the nearest edge tile, -1 only before the first update.
+    int  tileAt(const Vector2D& posLocal) const;
+
+  private:
+    struct STile {
+        CBox logical;
+        CBox pixel;
+    };
+
+    std::vector<STile> m_tiles;
+
+    Vector2D           m_origin;
+    Vector2D           m_pitch;
+    double             m_gap          = 0;
+    int                m_columns      = 1;
+    int                m_rows         = 1;
+    int                m_currentPage  = 0;
+    int                m_tilesPerPage = 1;
+};
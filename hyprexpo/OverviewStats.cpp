@@ -0,0 +1,250 @@
+#include "OverviewStats.hpp"
+#include "FramebufferPool.hpp"
+#include "overview.hpp"
+#include "globals.hpp"
+
+#include <hyprland/src/render/Renderer.hpp>
+#include <EGL/egl.h>
+#include <algorithm>
+
+static const char* seriesName(COverviewStats::eSeries series) {
+    switch (series) {
+        case COverviewStats::SERIES_OPEN_TO_FIRST_FRAME: return "open_to_first_frame_ms";
+        case COverviewStats::SERIES_TILE_REDRAW_CPU: return "tile_redraw_cpu_ms";
+        case COverviewStats::SERIES_TILE_REDRAW_GPU: return "tile_redraw_gpu_ms";
+        case COverviewStats::SERIES_COMPOSITE_CPU: return "composite_cpu_ms";
+        case COverviewStats::SERIES_COMPOSITE_GPU: return "composite_gpu_ms";
+        case COverviewStats::SERIES_TILES_PER_FRAME: return "tiles_per_frame";
+        case COverviewStats::SERIES_FRAME_INTERVAL: return "frame_interval_ms";
+        default: break;
+    }
+    return "unknown";
+}
+
+void COverviewStats::SSeries::push(float value) {
+    count++;
+    total += value;
+    max = std::max(max, value);
+
+    window[next] = value;
+    next         = (next + 1) % window.size();
+    filled       = std::min(filled + 1, window.size());
+}
+
+void COverviewStats::SSeries::resetSession() {
+    count = 0;
+    total = 0;
+    max   = 0;
+}
+
+std::vector<float> COverviewStats::SSeries::sorted() const {
+    std::vector<float> values{window.begin(), window.begin() + filled};
+    std::ranges::sort(values);
+    return values;
+}
+
+COverviewStats::COverviewStats() {
+    m_sessionStart = Time::steadyNow();
+}
+
+COverviewStats::~COverviewStats() {
+    if (!m_deleteQueries)
+        return;
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    for (auto const& p : m_pending) {
+        m_freeQueries.emplace_back(p.query);
+    }
+
+    if (!m_freeQueries.empty())
+        m_deleteQueries(m_freeQueries.size(), m_freeQueries.data());
+}
+
+void COverviewStats::onOverviewOpened() {
+    // overviews opening on other monitors during a session belong to it
+    if (std::ranges::any_of(g_overviews, [](const auto& e) { return !!e.second; }))
+        return;
+
+    m_sessions++;
+    m_sessionStart   = Time::steadyNow();
+    m_sessionDamage  = 0;
+    m_damageRequests = 0;
+    m_damageFlushes  = 0;
+
+    for (auto& s : m_series) {
+        s.resetSession();
+    }
+}
+
+void COverviewStats::onDamageReport() {
+    m_sessionDamage++;
+    m_totalDamage++;
+}
+
+void COverviewStats::onDamageRequest() {
+    m_damageRequests++;
+}
+
+void COverviewStats::onDamageFlush() {
+    m_damageFlushes++;
+}
+
+void COverviewStats::onWakeup() {
+    m_wakeups.emplace_back(Time::steadyNow());
+    wakeupsPerSecond();
+}
+
+size_t COverviewStats::wakeupsPerSecond() {
+    const auto SINCE = Time::steadyNow() - std::chrono::seconds(1);
+    while (!m_wakeups.empty() && m_wakeups.front() < SINCE) {
+        m_wakeups.pop_front();
+    }
+
+    return m_wakeups.size();
+}
+
+void COverviewStats::push(eSeries series, float value) {
+    m_series[series].push(value);
+}
+
+bool COverviewStats::initTimers() {
+    if (m_timersChecked)
+        return m_genQueries;
+
+    m_timersChecked = true;
+
+    const auto EXTENSIONS = (const char*)glGetString(GL_EXTENSIONS);
+    if (!EXTENSIONS || !std::string_view{EXTENSIONS}.contains("GL_EXT_disjoint_timer_query")) {
+        Log::logger->log(Log::LOG, "[he] no GL_EXT_disjoint_timer_query, gpu times won't be reported");
+        return false;
+    }
+
+    m_genQueries          = (PFNGLGENQUERIESEXTPROC)eglGetProcAddress("glGenQueriesEXT");
+    m_deleteQueries       = (PFNGLDELETEQUERIESEXTPROC)eglGetProcAddress("glDeleteQueriesEXT");
+    m_beginQuery          = (PFNGLBEGINQUERYEXTPROC)eglGetProcAddress("glBeginQueryEXT");
+    m_endQuery            = (PFNGLENDQUERYEXTPROC)eglGetProcAddress("glEndQueryEXT");
+    m_getQueryObjectuiv   = (PFNGLGETQUERYOBJECTUIVEXTPROC)eglGetProcAddress("glGetQueryObjectuivEXT");
+    m_getQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VEXTPROC)eglGetProcAddress("glGetQueryObjectui64vEXT");
+
+    if (!m_genQueries || !m_deleteQueries || !m_beginQuery || !m_endQuery || !m_getQueryObjectuiv || !m_getQueryObjectui64v) {
+        m_genQueries    = nullptr;
+        m_deleteQueries = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+GLuint COverviewStats::beginGpuTimer() {
+    // time elapsed queries can't nest
+    if (m_timerRunning || !initTimers())
+        return 0;
+
+    GLuint query = 0;
+    if (m_freeQueries.empty())
+        m_genQueries(1, &query);
+    else {
+        query = m_freeQueries.back();
+        m_freeQueries.pop_back();
+    }
+
+    m_beginQuery(GL_TIME_ELAPSED_EXT, query);
+    m_timerRunning = true;
+    return query;
+}
+
+void COverviewStats::endGpuTimer(GLuint query, eSeries series, size_t samples) {
+    if (!query)
+        return;
+
+    m_endQuery(GL_TIME_ELAPSED_EXT);
+    m_timerRunning = false;
+
+    m_pending.emplace_back(SPendingQuery{query, series, std::max<size_t>(samples, 1)});
+}
+
+void COverviewStats::pollGpuTimers() {
+    if (m_pending.empty())
+        return;
+
+    // a disjoint event makes everything in flight meaningless
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+    std::erase_if(m_pending, [this, disjoint](const auto& p) {
+        GLuint available = 0;
+        m_getQueryObjectuiv(p.query, GL_QUERY_RESULT_AVAILABLE_EXT, &available);
+        if (!available)
+            return false;
+
+        GLuint64 ns = 0;
+        m_getQueryObjectui64v(p.query, GL_QUERY_RESULT_EXT, &ns);
+
+        if (!disjoint) {
+            const float MS = ns / 1000000.F / p.samples;
+            for (size_t i = 0; i < p.samples; ++i) {
+                push(p.series, MS);
+            }
+        }
+
+        m_freeQueries.emplace_back(p.query);
+        return true;
+    });
+}
+
+void COverviewStats::reset() {
+    m_sessionDamage  = 0;
+    m_totalDamage    = 0;
+    m_damageRequests = 0;
+    m_damageFlushes  = 0;
+
+    for (auto& s : m_series) {
+        s = SSeries{};
+    }
+}
+
+std::string COverviewStats::toJson() {
+    std::string series;
+
+    for (size_t i = 0; i < SERIES_LAST; ++i) {
+        const auto& S      = m_series[i];
+        const auto  SORTED = S.sorted();
+
+        auto        percentile = [&SORTED](float p) { return SORTED.empty() ? 0.F : SORTED[std::min<size_t>(SORTED.size() - 1, p * SORTED.size())]; };
+        float       windowAvg  = 0;
+        for (const float v : SORTED) {
+            windowAvg += v;
+        }
+        if (!SORTED.empty())
+            windowAvg /= SORTED.size();
+
+        series += std::format(R"#({}
+        "{}": {{
+            "session": {{ "count": {}, "avg": {:.3f}, "max": {:.3f} }},
+            "rolling": {{ "samples": {}, "avg": {:.3f}, "p50": {:.3f}, "p99": {:.3f}, "max": {:.3f} }}
+        }})#",
+                              i == 0 ? "" : ",", seriesName((eSeries)i), S.count, S.count ? S.total / S.count : 0.0, S.max, SORTED.size(), windowAvg, percentile(0.5F),
+                              percentile(0.99F), SORTED.empty() ? 0.F : SORTED.back());
+    }
+
+    // every open overview is waiting for something to happen
+    const bool IDLE = !g_overviews.empty() && std::ranges::all_of(g_overviews, [](const auto& e) { return !e.second || e.second->idle; });
+
+    return std::format(R"#({{
+    "sessions": {},
+    "overviews_open": {},
+    "idle": {},
+    "wakeups_per_second": {},
+    "session_seconds": {:.1f},
+    "damage_reports": {{ "session": {}, "total": {} }},
+    "damage_coalescing": {{ "requests": {}, "flushes": {}, "merged": {} }},
+    "framebuffer_bytes": {{ "allocated": {}, "pooled": {} }},
+    "gpu_timers": {},
+    "series": {{{}
+    }}
+}})#",
+                       m_sessions, g_overviews.size(), IDLE ? "true" : "false", wakeupsPerSecond(), std::chrono::duration<float>(Time::steadyNow() - m_sessionStart).count(),
+                       m_sessionDamage, m_totalDamage, m_damageRequests, m_damageFlushes, m_damageRequests - std::min(m_damageFlushes, m_damageRequests),
+                       g_pFramebufferPool->bytesAllocated(), g_pFramebufferPool->bytesPooled(), m_genQueries ? "true" : "false", series);
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#define WLR_USE_UNSTABLE
+
+#include <hyprland/src/helpers/time/Time.hpp>
+#include <GLES3/gl32.h>
+#include <GLES2/gl2ext.h>
+#include <array>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Counters for finding out where overview time goes, dumped as json by `hyprctl hyprexpo`.
+// A session starts when the first overview opens; rolling windows span sessions.
+class COverviewStats {
+  public:
+    COverviewStats();
+    ~COverviewStats();
+
+    enum eSeries : uint8_t {
+        SERIES_OPEN_TO_FIRST_FRAME = 0,
+        SERIES_TILE_REDRAW_CPU,
+        SERIES_TILE_REDRAW_GPU,
+        SERIES_COMPOSITE_CPU,
+        SERIES_COMPOSITE_GPU,
+        SERIES_TILES_PER_FRAME,
+        SERIES_FRAME_INTERVAL,
+        SERIES_LAST,
+    };
+
+    void        onOverviewOpened();
+    void        onDamageReport();
+    // damage asked for by overviews, and how often what was collected actually got applied
+    void        onDamageRequest();
+    void        onDamageFlush();
+    // an overview frame, idle overviews don't have any
+    void        onWakeup();
+    void        push(eSeries series, float value);
+
+    // gpu time of everything submitted between begin and end, spread over `samples` entries of series once the
+    // result is in. Returns 0 if timer queries aren't supported, or one is already running.
+    GLuint      beginGpuTimer();
+    void        endGpuTimer(GLuint query, eSeries series, size_t samples = 1);
+    // collects finished timer queries, needs a current context
+    void        pollGpuTimers();
+
+    std::string toJson();
+    void        reset();
+
+  private:
+    struct SSeries {
+        // this session
+        uint64_t               count = 0;
+        double                 total = 0;
+        float                  max   = 0;
+
+        // the last samples of any session
+        std::array<float, 256> window = {};
+        size_t                 next   = 0;
+        size_t                 filled = 0;
+
+        void                   push(float value);
+        void                   resetSession();
+        std::vector<float>     sorted() const;
+    };
+
+    struct SPendingQuery {
+        GLuint  query   = 0;
+        eSeries series  = SERIES_LAST;
+        size_t  samples = 1;
+    };
+
+    bool                             initTimers();
+    size_t                           wakeupsPerSecond();
+
+    std::array<SSeries, SERIES_LAST> m_series;
+    uint64_t                         m_sessionDamage  = 0;
+    uint64_t                         m_totalDamage    = 0;
+    uint64_t                         m_damageRequests = 0;
+    uint64_t                         m_damageFlushes  = 0;
+    uint64_t                         m_sessions       = 0;
+    Time::steady_tp                  m_sessionStart;
+    std::deque<Time::steady_tp>      m_wakeups;
+
+    bool                             m_timersChecked = false;
+    bool                             m_timerRunning  = false;
+    std::vector<GLuint>              m_freeQueries;
+    std::vector<SPendingQuery>       m_pending;
+
+    PFNGLGENQUERIESEXTPROC           m_genQueries          = nullptr;
+    PFNGLDELETEQUERIESEXTPROC        m_deleteQueries       = nullptr;
+    PFNGLBEGINQUERYEXTPROC           m_beginQuery          = nullptr;
+    PFNGLENDQUERYEXTPROC             m_endQuery            = nullptr;
+    PFNGLGETQUERYOBJECTUIVEXTPROC    m_getQueryObjectuiv   = nullptr;
+    PFNGLGETQUERYOBJECTUI64VEXTPROC  m_getQueryObjectui64v = nullptr;
+};
+
+inline std::unique_ptr<COverviewStats> g_pOverviewStats;
@@ -0,0 +1,225 @@
+#include "ThumbnailCache.hpp"
+#include "FramebufferPool.hpp"
+#include "overview.hpp"
+#include "globals.hpp"
+
+#include <hyprland/src/Compositor.hpp>
+#include <hyprland/src/helpers/Monitor.hpp>
+#include <hyprland/src/managers/eventLoop/EventLoopManager.hpp>
+#include <hyprland/src/render/Renderer.hpp>
+
+CThumbnailCache::CThumbnailCache() {
+    for (auto const& m : g_pCompositor->m_monitors) {
+        m_lastActive[m->m_id] = m->m_activeWorkspace;
+    }
+
+    m_workspaceActiveListener = Event::bus()->m_events.workspace.active.listen([this](PHLWORKSPACE pWorkspace) { onWorkspaceActive(pWorkspace); });
+    m_configReloadedListener  = Event::bus()->m_events.config.reloaded.listen([this] { onConfigReloaded(); });
+
+    m_timer = makeShared<CEventLoopTimer>(std::nullopt, [this](SP<CEventLoopTimer> self, void* data) { onTick(); }, nullptr);
+    g_pEventLoopManager->addTimer(m_timer);
+    onConfigReloaded();
+}
+
+CThumbnailCache::~CThumbnailCache() {
+    g_pEventLoopManager->removeTimer(m_timer);
+
+    g_pHyprRenderer->makeEGLCurrent();
+    m_entries.clear();
+    m_scratch.reset();
+}
+
+bool CThumbnailCache::enabled() {
+    static auto* const* PENABLED = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:background_cache")->getDataStaticPtr();
+    return **PENABLED;
+}
+
+void CThumbnailCache::arm(std::chrono::milliseconds in) {
+    m_timer->updateTimeout(in);
+}
+
+SP<CFramebuffer> CThumbnailCache::take(PHLMONITOR pMonitor, WORKSPACEID id, const Vector2D& size) {
+    auto it = std::ranges::find_if(m_entries, [&](const auto& e) { return e.monitor == pMonitor->m_id && e.workspace == id; });
+    if (it == m_entries.end())
+        return nullptr;
+
+    auto fb = it->fb;
+    m_entries.erase(it);
+
+    // thumbnail_format may have changed since it was stored
+    if (fb->m_size != size || fb->m_drmFormat != COverview::tileFormatFor(pMonitor, size)) {
+        g_pFramebufferPool->release(fb);
+        return nullptr;
+    }
+
+    return fb;
+}
+
+void CThumbnailCache::store(PHLMONITOR pMonitor, WORKSPACEID id, SP<CFramebuffer> fb) {
+    if (!fb)
+        return;
+
+    // full size tiles from a zoom aren't worth keeping around
+    if (!enabled() || id == WORKSPACE_INVALID || fb->m_size != COverview::thumbnailSizeFor(pMonitor, COverview::gridConfig())) {
+        g_pFramebufferPool->release(fb);
+        return;
+    }
+
+    auto it = std::ranges::find_if(m_entries, [&](const auto& e) { return e.monitor == pMonitor->m_id && e.workspace == id; });
+    if (it != m_entries.end()) {
+        g_pFramebufferPool->release(it->fb);
+        it->fb = fb;
+        return;
+    }
+
+    m_entries.emplace_back(SEntry{pMonitor->m_id, id, fb});
+}
+
+std::chrono::milliseconds CThumbnailCache::interval() {
+    static auto* const* PINTERVAL = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:background_cache_interval")->getDataStaticPtr();
+
+    return std::chrono::milliseconds(std::max<Hyprlang::INT>(**PINTERVAL, 100));
+}
+
+void CThumbnailCache::rearm() {
+    // also called from an overview's destructor while it's still in g_overviews, onTick checks for open ones
+    if (!enabled())
+        return;
+
+    if (!m_pending.empty())
+        arm(std::chrono::milliseconds(500));
+    else if (!m_damaged.empty() && !m_timer->armed())
+        arm(interval());
+}
+
+void CThumbnailCache::dropAll() {
+    for (auto& e : m_entries) {
+        g_pFramebufferPool->release(e.fb);
+    }
+    m_entries.clear();
+    m_pending.clear();
+    m_damaged.clear();
+}
+
+void CThumbnailCache::onMonitorDamaged(MONITORID id) {
+    if (!enabled() || !m_damaged.emplace(id).second)
+        return;
+
+    rearm();
+}
+
+void CThumbnailCache::onOverviewClosed() {
+    rearm();
+}
+
+void CThumbnailCache::onConfigReloaded() {
+    if (!enabled()) {
+        dropAll();
+        m_timer->updateTimeout(std::nullopt);
+        return;
+    }
+
+    // start out with whatever is on screen now
+    for (auto const& m : g_pCompositor->m_monitors) {
+        m_damaged.emplace(m->m_id);
+    }
+
+    rearm();
+}
+
+void CThumbnailCache::onWorkspaceActive(PHLWORKSPACE pWorkspace) {
+    if (!pWorkspace || pWorkspace->m_isSpecialWorkspace)
+        return;
+
+    const auto PMONITOR = pWorkspace->m_monitor.lock();
+    if (!PMONITOR)
+        return;
+
+    const auto PREV = m_lastActive[PMONITOR->m_id];
+    m_lastActive[PMONITOR->m_id] = pWorkspace;
+
+    if (!enabled() || !PREV || PREV == pWorkspace)
+        return;
+
+    // the workspace we left is still sliding out, grab it once that settled
+    m_pending.emplace_back(PREV);
+    arm(std::chrono::milliseconds(500));
+}
+
+void CThumbnailCache::snapshot(PHLMONITOR pMonitor, PHLWORKSPACE pWorkspace) {
+    if (!pMonitor || !pMonitor->m_activeWorkspace || !pWorkspace || !pMonitor->m_output)
+        return;
+
+    auto it = std::ranges::find_if(m_entries, [&](const auto& e) { return e.monitor == pMonitor->m_id && e.workspace == pWorkspace->m_id; });
+    if (it == m_entries.end())
+        it = m_entries.emplace(m_entries.end(), SEntry{pMonitor->m_id, pWorkspace->m_id, nullptr});
+
+    const auto SIZE = COverview::thumbnailSizeFor(pMonitor, COverview::gridConfig());
+    g_pFramebufferPool->resize(it->fb, SIZE, COverview::tileFormatFor(pMonitor, SIZE));
+
+    m_rendering = true;
+    COverview::renderWorkspaceThumbnail(pMonitor, pWorkspace, pMonitor->m_activeWorkspace, *it->fb, {{}, SIZE}, m_scratch);
+    COverview::updateMipmaps(*it->fb);
+    m_rendering = false;
+}
+
+void CThumbnailCache::purge() {
+    std::erase_if(m_entries, [](const auto& e) {
+        if (g_pCompositor->getWorkspaceByID(e.workspace) && g_pCompositor->getMonitorFromID(e.monitor))
+            return false;
+
+        g_pFramebufferPool->release(e.fb);
+        return true;
+    });
+}
+
+void CThumbnailCache::onTick() {
+    if (!enabled()) {
+        dropAll();
+        return;
+    }
+
+    // the overview keeps its own tiles fresh while it's open, onOverviewClosed picks up from here
+    if (!g_overviews.empty())
+        return;
+
+    purge();
+
+    std::vector<PHLWORKSPACEREF> stillPending;
+
+    for (auto const& ref : m_pending) {
+        const auto PWORKSPACE = ref.lock();
+        if (!PWORKSPACE || PWORKSPACE->m_visible)
+            continue;
+
+        if (PWORKSPACE->m_renderOffset->isBeingAnimated() || PWORKSPACE->m_alpha->isBeingAnimated()) {
+            stillPending.emplace_back(ref);
+            continue;
+        }
+
+        snapshot(PWORKSPACE->m_monitor.lock(), PWORKSPACE);
+    }
+
+    m_pending = std::move(stillPending);
+
+    // keep the active workspaces roughly up to date as well, but only if something changed on them
+    std::unordered_set<MONITORID> stillDamaged;
+
+    for (const auto ID : m_damaged) {
+        const auto PMONITOR = g_pCompositor->getMonitorFromID(ID);
+        if (!PMONITOR || !PMONITOR->m_activeWorkspace)
+            continue;
+
+        const auto PWORKSPACE = PMONITOR->m_activeWorkspace;
+        if (PWORKSPACE->m_renderOffset->isBeingAnimated() || PWORKSPACE->m_alpha->isBeingAnimated()) {
+            stillDamaged.emplace(ID);
+            continue;
+        }
+
+        snapshot(PMONITOR, PWORKSPACE);
+    }
+
+    m_damaged = std::move(stillDamaged);
+
+    rearm();
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#define WLR_USE_UNSTABLE
+
+#include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <hyprland/src/render/Framebuffer.hpp>
+#include <hyprland/src/managers/eventLoop/EventLoopTimer.hpp>
+#include <hyprland/src/event/EventBus.hpp>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Keeps workspace thumbnails warm while the overview is closed, so opening it
+// can show real images right away. Snapshots are taken when a workspace is
+// switched away from and, at a low rate, of damaged active workspaces.
+class CThumbnailCache {
+  public:
+    CThumbnailCache();
+    ~CThumbnailCache();
+
+    // hands over the cached thumbnail of a workspace, if there is one of the right size
+    SP<CFramebuffer> take(PHLMONITOR pMonitor, WORKSPACEID id, const Vector2D& size);
+    // keeps a thumbnail for the next session, or gives it back to the pool
+    void             store(PHLMONITOR pMonitor, WORKSPACEID id, SP<CFramebuffer> fb);
+
+    void             onMonitorDamaged(MONITORID id);
+    // an overview closed, snapshots that waited for it can go ahead
+    void             onOverviewClosed();
+    bool             enabled();
+
+    // set while we render offscreen, our own damage should be ignored
+    bool             m_rendering = false;
+
+  private:
+    struct SEntry {
+        MONITORID        monitor   = -1;
+        WORKSPACEID      workspace = WORKSPACE_INVALID;
+        SP<CFramebuffer> fb;
+    };
+
+    void                                           onTick();
+    void                                           onConfigReloaded();
+    void                                           onWorkspaceActive(PHLWORKSPACE pWorkspace);
+    void                                           snapshot(PHLMONITOR pMonitor, PHLWORKSPACE pWorkspace);
+    void                                           purge();
+    void                                           arm(std::chrono::milliseconds in);
+    // re-arms the timer if anything is left to snapshot, otherwise it sleeps until damage or a workspace switch
+    void                                           rearm();
+    std::chrono::milliseconds                      interval();
+    void                                           dropAll();
+
+    std::vector<SEntry>                            m_entries;
+    std::vector<PHLWORKSPACEREF>                   m_pending;
+    std::unordered_map<MONITORID, PHLWORKSPACEREF> m_lastActive;
+    std::unordered_set<MONITORID>                  m_damaged;
+    SP<CFramebuffer>                               m_scratch;
+    SP<CEventLoopTimer>                            m_timer;
+
+    CHyprSignalListener                            m_workspaceActiveListener;
+    CHyprSignalListener                            m_configReloadedListener;
+};
+
+inline std::unique_ptr<CThumbnailCache> g_pThumbnailCache;
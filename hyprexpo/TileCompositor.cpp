@@ -0,0 +1,181 @@
+#include "TileCompositor.hpp"
+#include "globals.hpp"
+
+#include <hyprland/src/render/OpenGL.hpp>
+#include <hyprland/src/render/Renderer.hpp>
+#include <hyprutils/math/Mat3x3.hpp>
+
+// one instance per tile: the tile's projection as three rows, its rect in the atlas and the hover tint
+static const std::string TILEVERT = R"#(#version 300 es
+precision highp float;
+
+layout(location = 0) in vec2 corner;
+layout(location = 1) in vec3 row0;
+layout(location = 2) in vec3 row1;
+layout(location = 3) in vec3 row2;
+layout(location = 4) in vec4 uvRect;
+layout(location = 5) in float highlight;
+
+out vec2  v_texcoord;
+out float v_highlight;
+
+void main() {
+    mat3 proj   = transpose(mat3(row0, row1, row2));
+    gl_Position = vec4(proj * vec3(corner, 1.0), 1.0);
+    v_texcoord  = uvRect.xy + corner * uvRect.zw;
+    v_highlight = highlight;
+}
+)#";
+
+static const std::string TILEFRAG = R"#(#version 300 es
+precision highp float;
+
+in vec2  v_texcoord;
+in float v_highlight;
+
+uniform sampler2D tex;
+
+layout(location = 0) out vec4 fragColor;
+
+void main() {
+    vec3 color = texture(tex, v_texcoord).rgb;
+    fragColor  = vec4(mix(color, vec3(1.0), v_highlight), 1.0);
+}
+)#";
+
+// same corner order as hyprland's own quads
+static const float QUAD[] = {1, 0, 0, 0, 1, 1, 0, 1};
+
+CTileCompositor::~CTileCompositor() {
+    if (!m_initialized)
+        return;
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    glDeleteBuffers(1, &m_instanceBuffer);
+    glDeleteBuffers(1, &m_quadBuffer);
+    glDeleteVertexArrays(1, &m_vao);
+    glDeleteProgram(m_program);
+}
+
+bool CTileCompositor::failed() const {
+    return m_failed;
+}
+
+bool CTileCompositor::ready() {
+    if (m_initialized || m_failed)
+        return m_initialized;
+
+    m_program = g_pHyprOpenGL->createProgram(TILEVERT, TILEFRAG, true, true);
+    if (!m_program) {
+        Log::logger->log(Log::ERR, "[he] tile shader failed to compile, compositing tiles one by one");
+        m_failed = true;
+        return false;
+    }
+
+    m_texLocation = glGetUniformLocation(m_program, "tex");
+
+    GLint prevVAO = 0, prevBuffer = 0;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &prevVAO);
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &prevBuffer);
+
+    glGenVertexArrays(1, &m_vao);
+    glBindVertexArray(m_vao);
+
+    glGenBuffers(1, &m_quadBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_quadBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(QUAD), QUAD, GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+    glGenBuffers(1, &m_instanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+
+    const auto STRIDE = sizeof(SInstance);
+    for (GLuint row = 0; row < 3; ++row) {
+        glEnableVertexAttribArray(1 + row);
+        glVertexAttribPointer(1 + row, 3, GL_FLOAT, GL_FALSE, STRIDE, (void*)(offsetof(SInstance, matrix) + row * 3 * sizeof(float)));
+        glVertexAttribDivisor(1 + row, 1);
+    }
+
+    glEnableVertexAttribArray(4);
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, STRIDE, (void*)offsetof(SInstance, uv));
+    glVertexAttribDivisor(4, 1);
+
+    glEnableVertexAttribArray(5);
+    glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, STRIDE, (void*)offsetof(SInstance, highlight));
+    glVertexAttribDivisor(5, 1);
+
+    glBindVertexArray(prevVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, prevBuffer);
+
+    m_initialized = true;
+    return true;
+}
+
+void CTileCompositor::add(const CBox& box, const CBox& uv, float highlight) {
+    const auto& RENDERDATA = g_pHyprOpenGL->m_renderData;
+
+    Mat3x3      matrix   = RENDERDATA.monitorProjection.projectBox(box, HYPRUTILS_TRANSFORM_NORMAL, box.rot);
+    Mat3x3      glMatrix = RENDERDATA.projection.copy().multiply(matrix);
+
+    SInstance   instance;
+    instance.matrix    = glMatrix.getMatrix();
+    instance.uv        = {(float)uv.x, (float)uv.y, (float)uv.w, (float)uv.h};
+    instance.highlight = highlight;
+
+    m_instances.emplace_back(instance);
+}
+
+void CTileCompositor::flush(CFramebuffer& atlas, const CRegion& damage) {
+    if (m_instances.empty())
+        return;
+
+    if (!ready()) {
+        m_instances.clear();
+        return;
+    }
+
+    // the atlas is sampled with linear filtering, keep half a texel off the slot edges so neighbours don't bleed in
+    const Vector2D ATLASSIZE = atlas.m_size;
+    for (auto& instance : m_instances) {
+        instance.uv = {(float)((instance.uv[0] + 0.5F) / ATLASSIZE.x), (float)((instance.uv[1] + 0.5F) / ATLASSIZE.y), (float)((instance.uv[2] - 1.F) / ATLASSIZE.x),
+                       (float)((instance.uv[3] - 1.F) / ATLASSIZE.y)};
+    }
+
+    // hyprland tracks its own gl state, leave it as we found it
+    GLint prevProgram = 0, prevVAO = 0, prevBuffer = 0, prevTexture = 0, prevActiveTexture = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &prevProgram);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &prevVAO);
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &prevBuffer);
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &prevActiveTexture);
+    glActiveTexture(GL_TEXTURE0);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &prevTexture);
+    const bool BLEND = glIsEnabled(GL_BLEND);
+
+    glDisable(GL_BLEND);
+    glUseProgram(m_program);
+    glUniform1i(m_texLocation, 0);
+    glBindTexture(GL_TEXTURE_2D, atlas.getTexture()->m_texID);
+
+    glBindVertexArray(m_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, m_instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, m_instances.size() * sizeof(SInstance), m_instances.data(), GL_STREAM_DRAW);
+
+    for (auto const& RECT : damage.getRects()) {
+        g_pHyprOpenGL->scissor(&RECT);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, m_instances.size());
+    }
+
+    g_pHyprOpenGL->scissor(nullptr);
+
+    glBindVertexArray(prevVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, prevBuffer);
+    glBindTexture(GL_TEXTURE_2D, prevTexture);
+    glActiveTexture(prevActiveTexture);
+    glUseProgram(prevProgram);
+    if (BLEND)
+        glEnable(GL_BLEND);
+
+    m_instances.clear();
+}
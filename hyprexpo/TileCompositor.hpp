@@ -0,0 +1,45 @@
+#pragma once
+
+#define WLR_USE_UNSTABLE
+
+#include <hyprland/src/render/Framebuffer.hpp>
+#include <array>
+#include <vector>
+
+// Composites overview tiles that live in one atlas texture with a single
+// instanced draw per damage rect, instead of a renderTexture per tile.
+class CTileCompositor {
+  public:
+    CTileCompositor() = default;
+    ~CTileCompositor();
+
+    // compiles the shader on first use, false if it isn't usable. Needs a current context.
+    bool ready();
+    // the shader was tried and didn't compile. Touches no GL, unlike ready().
+    bool failed() const;
+
+    // box is where the tile goes on the monitor, uv its rect in the atlas in pixels
+    void add(const CBox& box, const CBox& uv, float highlight);
+    // draws everything added so far
+    void flush(CFramebuffer& atlas, const CRegion& damage);
+
+  private:
+    struct SInstance {
+        std::array<float, 9> matrix;
+        std::array<float, 4> uv;
+        float                highlight = 0.F;
+    };
+
+    bool                   m_initialized = false;
+    bool                   m_failed      = false;
+
+    GLuint                 m_program        = 0;
+    GLint                  m_texLocation    = -1;
+    GLuint                 m_vao            = 0;
+    GLuint                 m_quadBuffer     = 0;
+    GLuint                 m_instanceBuffer = 0;
+
+    std::vector<SInstance> m_instances;
+};
+
+inline std::unique_ptr<CTileCompositor> g_pTileCompositor;
@@ -0,0 +1,96 @@
+#include "WorkspaceIndex.hpp"
+
+#include <hyprland/src/Compositor.hpp>
+#include <algorithm>
+
+CWorkspaceIndex::CWorkspaceIndex() {
+    for (auto const& w : g_pCompositor->m_workspaces) {
+        if (const auto PWORKSPACE = w.lock(); PWORKSPACE)
+            onCreated(PWORKSPACE);
+    }
+
+    m_createdListener = Event::bus()->m_events.workspace.created.listen([this](PHLWORKSPACE pWorkspace) { onCreated(pWorkspace); });
+    m_removedListener = Event::bus()->m_events.workspace.removed.listen([this](PHLWORKSPACEREF pWorkspace) { onRemoved(pWorkspace); });
+}
+
+void CWorkspaceIndex::onCreated(PHLWORKSPACE pWorkspace) {
+    if (!pWorkspace)
+        return;
+
+    const auto IT = std::ranges::lower_bound(m_entries, pWorkspace->m_id, {}, &SEntry::id);
+
+    // ids get reused, a stale entry may still be around if its removal wasn't reported
+    if (IT != m_entries.end() && IT->id == pWorkspace->m_id) {
+        IT->workspace = pWorkspace;
+        return;
+    }
+
+    m_entries.insert(IT, SEntry{pWorkspace->m_id, pWorkspace});
+}
+
+void CWorkspaceIndex::onRemoved(PHLWORKSPACEREF pWorkspace) {
+    const auto PWORKSPACE = pWorkspace.lock();
+    std::erase_if(m_entries, [&PWORKSPACE](const auto& e) { return e.workspace.expired() || e.workspace.lock() == PWORKSPACE; });
+}
+
+bool CWorkspaceIndex::onMonitor(const SEntry& entry, PHLMONITOR pMonitor) {
+    const auto PWORKSPACE = entry.workspace.lock();
+    return PWORKSPACE && !PWORKSPACE->m_isSpecialWorkspace && PWORKSPACE->m_monitor == pMonitor;
+}
+
+bool CWorkspaceIndex::ownedElsewhere(const SEntry& entry, PHLMONITOR pMonitor) {
+    const auto PWORKSPACE = entry.workspace.lock();
+    return PWORKSPACE && PWORKSPACE->m_monitor != pMonitor;
+}
+
+std::vector<WORKSPACEID> CWorkspaceIndex::above(PHLMONITOR pMonitor, WORKSPACEID from, bool includeEmpty, size_t max) {
+    std::vector<WORKSPACEID> ids;
+    auto                     it = std::ranges::upper_bound(m_entries, from, {}, &SEntry::id);
+
+    if (!includeEmpty) {
+        for (; it != m_entries.end() && ids.size() < max; ++it) {
+            if (onMonitor(*it, pMonitor))
+                ids.emplace_back(it->id);
+        }
+        return ids;
+    }
+
+    for (WORKSPACEID id = std::max<WORKSPACEID>(from + 1, 1); ids.size() < max; ++id) {
+        while (it != m_entries.end() && it->id < id) {
+            ++it;
+        }
+
+        if (it != m_entries.end() && it->id == id && ownedElsewhere(*it, pMonitor))
+            continue;
+
+        ids.emplace_back(id);
+    }
+
+    return ids;
+}
+
+std::vector<WORKSPACEID> CWorkspaceIndex::below(PHLMONITOR pMonitor, WORKSPACEID from, bool includeEmpty, size_t max) {
+    std::vector<WORKSPACEID> ids;
+    auto                     it = std::make_reverse_iterator(std::ranges::lower_bound(m_entries, from, {}, &SEntry::id));
+
+    if (!includeEmpty) {
+        for (; it != m_entries.rend() && ids.size() < max; ++it) {
+            if (onMonitor(*it, pMonitor))
+                ids.emplace_back(it->id);
+        }
+        return ids;
+    }
+
+    for (WORKSPACEID id = from - 1; id >= 1 && ids.size() < max; --id) {
+        while (it != m_entries.rend() && it->id > id) {
+            ++it;
+        }
+
+        if (it != m_entries.rend() && it->id == id && ownedElsewhere(*it, pMonitor))
+            continue;
+
+        ids.emplace_back(id);
+    }
+
+    return ids;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#define WLR_USE_UNSTABLE
+
+#include <hyprland/src/desktop/DesktopTypes.hpp>
+#include <hyprland/src/event/EventBus.hpp>
+#include <vector>
+
+// All workspaces ordered by id, kept current from create/remove events. Filling the grid is
+// then a walk over this list rather than resolving an "r+N"/"m+N" selector per tile.
+class CWorkspaceIndex {
+  public:
+    CWorkspaceIndex();
+
+    // up to max workspace ids after `from` on pMonitor, nearest first. With includeEmpty this
+    // follows the "r" selector and yields ids that don't exist yet, skipping ones owned by
+    // other monitors; otherwise it follows "m" and only yields open workspaces.
+    std::vector<WORKSPACEID> above(PHLMONITOR pMonitor, WORKSPACEID from, bool includeEmpty, size_t max);
+    // same, walking down towards 1
+    std::vector<WORKSPACEID> below(PHLMONITOR pMonitor, WORKSPACEID from, bool includeEmpty, size_t max);
+
+  private:
+    struct SEntry {
+        WORKSPACEID     id = WORKSPACE_INVALID;
+        PHLWORKSPACEREF workspace;
+    };
+
+    void                onCreated(PHLWORKSPACE pWorkspace);
+    void                onRemoved(PHLWORKSPACEREF pWorkspace);
+    // an open, non-special workspace on pMonitor
+    bool                onMonitor(const SEntry& entry, PHLMONITOR pMonitor);
+    // an open workspace some other monitor has, "r" steps over these
+    bool                ownedElsewhere(const SEntry& entry, PHLMONITOR pMonitor);
+
+    std::vector<SEntry> m_entries;
+
+    CHyprSignalListener m_createdListener;
+    CHyprSignalListener m_removedListener;
+};
+
+inline std::unique_ptr<CWorkspaceIndex> g_pWorkspaceIndex;
@@ -0,0 +1,158 @@
+#!/usr/bin/env bash
+# Opens, swipes and closes hyprexpo in a headless, software rendered Hyprland and
+# reports what `hyprctl hyprexpo` measured, per grid size.
+#
+# frame_* is the time between frames while an overview was busy, composite_* the cpu
+# time of drawing the grid in one of them. vram_mib is what the framebuffer pool has
+# allocated, standing in for video memory the headless renderer doesn't report.
+#
+#   bench/run.sh path/to/hyprexpo.so
+#
+# Knobs, all optional:
+#   BENCH_GRIDS       column counts to try                     "2 3 4 6"
+#   BENCH_WORKSPACES  workspaces to spread clients over        9
+#   BENCH_CLIENTS     clients per workspace                    2
+#   BENCH_CLIENT      command spawning one client              weston-simple-shm
+#   BENCH_ITERATIONS  open/close cycles per path and grid      10
+#   BENCH_MONITOR     headless output mode                     1920x1080@60
+#   BENCH_OUTPUT      also write the raw json per grid here
+#   HYPRLAND          Hyprland binary                          Hyprland
+
+set -euo pipefail
+
+PLUGIN="$(realpath "${1:?usage: $0 path/to/hyprexpo.so}")"
+
+GRIDS="${BENCH_GRIDS:-2 3 4 6}"
+WORKSPACES="${BENCH_WORKSPACES:-9}"
+CLIENTS="${BENCH_CLIENTS:-2}"
+CLIENT="${BENCH_CLIENT:-weston-simple-shm}"
+ITERATIONS="${BENCH_ITERATIONS:-10}"
+MONITOR="${BENCH_MONITOR:-1920x1080@60}"
+HYPRLAND="${HYPRLAND:-Hyprland}"
+
+for tool in "$HYPRLAND" hyprctl jq; do
+    command -v "$tool" >/dev/null || { echo "bench: $tool not found" >&2; exit 1; }
+done
+
+WORKDIR="$(mktemp -d)"
+trap 'kill "$HYPRPID" 2>/dev/null || true; wait "$HYPRPID" 2>/dev/null || true; rm -rf "$WORKDIR"' EXIT
+
+# no gpu needed, mesa's llvmpipe does the rendering
+export HYPRLAND_HEADLESS_ONLY=1
+export LIBGL_ALWAYS_SOFTWARE=1
+export GALLIUM_DRIVER=llvmpipe
+export WLR_RENDERER_ALLOW_SOFTWARE=1
+export XDG_RUNTIME_DIR="$WORKDIR/runtime"
+mkdir -p -m 700 "$XDG_RUNTIME_DIR"
+
+cat >"$WORKDIR/hyprland.conf" <<EOF
+monitor = , $MONITOR, 0x0, 1
+plugin = $PLUGIN
+
+misc {
+    disable_hyprland_logo = true
+    disable_splash_rendering = true
+}
+
+plugin {
+    hyprexpo {
+        live_preview = all
+        refresh_max_tiles = 0
+    }
+}
+EOF
+
+"$HYPRLAND" --config "$WORKDIR/hyprland.conf" >"$WORKDIR/hyprland.log" 2>&1 &
+HYPRPID=$!
+
+# wait for the socket, hyprctl picks the only instance in our runtime dir
+for _ in $(seq 100); do
+    hyprctl instances -j 2>/dev/null | jq -e 'length > 0' >/dev/null 2>&1 && break
+    sleep 0.1
+done
+export HYPRLAND_INSTANCE_SIGNATURE="$(hyprctl instances -j | jq -r '.[0].instance')"
+
+hyprctl output create headless BENCH-1 >/dev/null
+sleep 0.5
+
+hctl() {
+    hyprctl "$@" >/dev/null
+}
+
+for ws in $(seq "$WORKSPACES"); do
+    for _ in $(seq "$CLIENTS"); do
+        hctl dispatch exec "[workspace $ws silent] $CLIENT"
+    done
+done
+hctl dispatch workspace 1
+sleep 2
+
+swipe() {
+    local kind="$1" dir="$2"
+    hctl dispatch hyprexpo:swipe begin "$kind"
+    for _ in $(seq 30); do
+        hctl dispatch hyprexpo:swipe update "$((dir * 4))" "$((dir * 8))"
+        sleep 0.016
+    done
+    hctl dispatch hyprexpo:swipe end
+}
+
+printf '%-6s %-10s %14s %14s %14s %14s %14s %14s %14s %12s\n' grid path open_p50_ms open_p99_ms frame_p50_ms frame_p99_ms composite_p50_ms composite_p99_ms tile_p99_ms vram_mib
+
+run_path() {
+    local grid="$1" path="$2"
+
+    hctl hyprexpo reset
+
+    for _ in $(seq "$ITERATIONS"); do
+        case "$path" in
+            toggle)
+                hctl dispatch hyprexpo:expo toggle
+                sleep 1
+                hctl dispatch hyprexpo:expo toggle
+                ;;
+            select)
+                hctl dispatch hyprexpo:expo on
+                sleep 1
+                hctl dispatch hyprexpo:expo select
+                ;;
+            close)
+                hctl dispatch hyprexpo:expo on
+                sleep 1
+                hctl dispatch hyprexpo:expo off
+                ;;
+            expo-swipe)
+                swipe expo -1
+                sleep 1
+                hctl dispatch hyprexpo:expo off
+                ;;
+            swish-swipe)
+                swipe swish 1
+                ;;
+        esac
+        sleep 1
+        hctl dispatch workspace 1
+    done
+
+    local stats
+    stats="$(hyprctl hyprexpo)"
+    [ -n "${BENCH_OUTPUT:-}" ] && mkdir -p "$BENCH_OUTPUT" && echo "$stats" >"$BENCH_OUTPUT/grid-$grid-$path.json"
+
+    echo "$stats" | jq -r --arg grid "$grid" --arg path "$path" '
+        [$grid, $path,
+         .series.open_to_first_frame_ms.rolling.p50, .series.open_to_first_frame_ms.rolling.p99,
+         .series.frame_interval_ms.rolling.p50, .series.frame_interval_ms.rolling.p99,
+         .series.composite_cpu_ms.rolling.p50, .series.composite_cpu_ms.rolling.p99,
+         .series.tile_redraw_cpu_ms.rolling.p99,
+         (.framebuffer_bytes.allocated / 1048576)]
+        | map(tostring) | join("\t")' |
+        awk -F'\t' '{ printf "%-6s %-10s %14.2f %14.2f %14.2f %14.2f %14.2f %14.2f %14.2f %12.1f\n", $1, $2, $3, $4, $5, $6, $7, $8, $9, $10 }'
+}
+
+for grid in $GRIDS; do
+    hctl keyword plugin:hyprexpo:columns "$grid"
+
+    for path in toggle select close expo-swipe swish-swipe; do
+        run_path "$grid" "$path"
+    done
+done
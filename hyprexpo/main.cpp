@@ -9,15 +9,23 @@
 #include <hyprland/src/config/ConfigManager.hpp>
 #include <hyprland/src/desktop/DesktopTypes.hpp>
 #include <hyprland/src/render/Renderer.hpp>
+#include <hyprland/src/protocols/core/Compositor.hpp>
 #include <hyprland/src/managers/input/trackpad/GestureTypes.hpp>
 #include <hyprland/src/managers/input/trackpad/TrackpadGestures.hpp>
 #include <hyprland/src/desktop/state/FocusState.hpp>
 #include <hyprland/src/event/EventBus.hpp>
+#include <hyprland/src/debug/HyprCtl.hpp>
 #include <hyprutils/string/ConstVarList.hpp>
+#include <hyprutils/string/VarList.hpp>
 using namespace Hyprutils::String;
 
 #include "globals.hpp"
 #include "overview.hpp"
+#include "FramebufferPool.hpp"
+#include "ThumbnailCache.hpp"
+#include "TileCompositor.hpp"
+#include "OverviewStats.hpp"
+#include "WorkspaceIndex.hpp"
 #include "ExpoGesture.hpp"
 #include "SwishGesture.hpp"
 
@@ -25,11 +33,15 @@ using namespace Hyprutils::String;
 inline CFunctionHook* g_pRenderWorkspaceHook = nullptr;
 inline CFunctionHook* g_pAddDamageHookA      = nullptr;
 inline CFunctionHook* g_pAddDamageHookB      = nullptr;
+inline CFunctionHook* g_pDamageSurfaceHook    = nullptr;
 typedef void (*origRenderWorkspace)(void*, PHLMONITOR, PHLWORKSPACE, timespec*, const CBox&);
 typedef void (*origAddDamageA)(void*, const CBox&);
 typedef void (*origAddDamageB)(void*, const pixman_region32_t*);
+typedef void (*origDamageSurface)(void*, SP<CWLSurfaceResource>, double, double, double);
 
 static bool g_unloading = false;
+// whose surface the damage being reported comes from, so the overview knows which tile changed
+static COverview::SDamageOwner damagingOwner;
 
 // Do NOT change this function.
 APICALL EXPORT std::string PLUGIN_API_VERSION() {
@@ -42,71 +54,172 @@ const std::string KEYWORD_EXPO_GESTURE = "hyprexpo-gesture";
 
 //
 static void hkRenderWorkspace(void* thisptr, PHLMONITOR pMonitor, PHLWORKSPACE pWorkspace, timespec* now, const CBox& geometry) {
-    if (!g_pOverview || renderingOverview || g_pOverview->blockOverviewRendering || g_pOverview->pMonitor != pMonitor)
+    const auto POVERVIEW = renderingOverview ? nullptr : overviewFor(pMonitor->m_id);
+
+    if (!POVERVIEW || POVERVIEW->blockOverviewRendering)
         ((origRenderWorkspace)(g_pRenderWorkspaceHook->m_original))(thisptr, pMonitor, pWorkspace, now, geometry);
     else
-        g_pOverview->render();
+        POVERVIEW->render();
 }
 
 static void hkAddDamageA(void* thisptr, const CBox& box) {
     const auto PMONITOR = (CMonitor*)thisptr;
 
-    if (!g_pOverview || g_pOverview->pMonitor != PMONITOR->m_self || g_pOverview->blockDamageReporting) {
+    if (g_pThumbnailCache && g_pThumbnailCache->m_rendering)
+        return;
+
+    const auto POVERVIEW = overviewFor(PMONITOR->m_id);
+
+    if (!POVERVIEW || POVERVIEW->blockDamageReporting) {
+        if (!POVERVIEW && g_pThumbnailCache)
+            g_pThumbnailCache->onMonitorDamaged(PMONITOR->m_id);
+
         ((origAddDamageA)g_pAddDamageHookA->m_original)(thisptr, box);
         return;
     }
 
-    g_pOverview->onDamageReported();
+    POVERVIEW->onDamageReported(box, damagingOwner);
 }
 
 static void hkAddDamageB(void* thisptr, const pixman_region32_t* rg) {
     const auto PMONITOR = (CMonitor*)thisptr;
 
-    if (!g_pOverview || g_pOverview->pMonitor != PMONITOR->m_self || g_pOverview->blockDamageReporting) {
+    if (g_pThumbnailCache && g_pThumbnailCache->m_rendering)
+        return;
+
+    const auto POVERVIEW = overviewFor(PMONITOR->m_id);
+
+    if (!POVERVIEW || POVERVIEW->blockDamageReporting) {
+        if (!POVERVIEW && g_pThumbnailCache)
+            g_pThumbnailCache->onMonitorDamaged(PMONITOR->m_id);
+
         ((origAddDamageB)g_pAddDamageHookB->m_original)(thisptr, rg);
         return;
     }
 
-    g_pOverview->onDamageReported();
+    const auto EXTENTS = pixman_region32_extents(rg);
+    POVERVIEW->onDamageReported(CBox{EXTENTS->x1, EXTENTS->y1, EXTENTS->x2 - EXTENTS->x1, EXTENTS->y2 - EXTENTS->y1}, damagingOwner);
+}
+
+static void hkDamageSurface(void* thisptr, SP<CWLSurfaceResource> pSurface, double x, double y, double scale) {
+    if (!g_overviews.empty())
+        damagingOwner = COverview::damageOwnerOf(pSurface);
+
+    ((origDamageSurface)g_pDamageSurfaceHook->m_original)(thisptr, pSurface, x, y, scale);
+
+    damagingOwner = {};
+}
+
+static COverview* openOverview(PHLMONITOR pMonitor) {
+    renderingOverview = true;
+    auto& overview    = g_overviews[pMonitor->m_id];
+    overview          = std::make_unique<COverview>(pMonitor->m_activeWorkspace, false, 0);
+    renderingOverview = false;
+    return overview.get();
 }
 
 static SDispatchResult onExpoDispatcher(std::string arg) {
+    // "all" as the second word applies the action to every monitor instead of just the focused one
+    CVarList                args{arg, 0, 's', true};
+    const std::string       ACTION = args[0];
+    std::vector<PHLMONITOR> monitors;
+
+    if (args.size() > 1 && args[1] == "all")
+        monitors = {g_pCompositor->m_monitors.begin(), g_pCompositor->m_monitors.end()};
+    else if (const auto PMONITOR = Desktop::focusState()->monitor(); PMONITOR)
+        monitors = {PMONITOR};
+
+    for (auto const& m : monitors) {
+        const auto POVERVIEW = overviewFor(m->m_id);
+        if (POVERVIEW && POVERVIEW->m_isSwiping)
+            return {.success = false, .error = "already swiping"};
+    }
 
-    if (g_pOverview && g_pOverview->m_isSwiping)
-        return {.success = false, .error = "already swiping"};
+    // toggling several monitors with mixed state opens the rest rather than flipping each
+    const bool ANYCLOSED = std::ranges::any_of(monitors, [](const auto& m) { return !overviewFor(m->m_id); });
 
-    if (arg == "select") {
-        if (g_pOverview) {
-            g_pOverview->selectHoveredWorkspace();
-            g_pOverview->close();
+    for (auto const& m : monitors) {
+        const auto POVERVIEW = overviewFor(m->m_id);
+
+        if (ACTION == "select") {
+            if (POVERVIEW) {
+                POVERVIEW->selectHoveredWorkspace();
+                POVERVIEW->close();
+            }
+            continue;
         }
-        return {};
-    }
-    if (arg == "toggle") {
-        if (g_pOverview)
-            g_pOverview->close();
-        else {
-            renderingOverview        = true;
-            g_pOverview              = std::make_unique<COverview>(Desktop::focusState()->monitor()->m_activeWorkspace, false, 0);
-            g_pOverview->fullyOpened = true;
-            renderingOverview        = false;
+
+        if (ACTION == "toggle") {
+            if (POVERVIEW && !ANYCLOSED)
+                POVERVIEW->close();
+            else if (!POVERVIEW)
+                openOverview(m)->fullyOpened = true;
+            continue;
+        }
+
+        if (ACTION == "off" || ACTION == "close" || ACTION == "disable") {
+            if (POVERVIEW)
+                POVERVIEW->close();
+            continue;
         }
+
+        if (ACTION == "nextpage" || ACTION == "prevpage") {
+            if (POVERVIEW)
+                POVERVIEW->changePage(ACTION == "nextpage" ? 1 : -1);
+            continue;
+        }
+
+        if (!POVERVIEW)
+            openOverview(m);
+    }
+
+    return {};
+}
+
+// drives an overview the way the trackpad gestures do, for scripts and the benchmark
+static SDispatchResult onSwipeDispatcher(std::string arg) {
+    CVarList   args{arg, 0, 's', true};
+
+    const auto PMONITOR = Desktop::focusState()->monitor();
+    if (!PMONITOR)
+        return {.success = false, .error = "no focused monitor"};
+
+    const auto POVERVIEW = overviewFor(PMONITOR->m_id);
+
+    if (args[0] == "begin") {
+        if (POVERVIEW)
+            return {.success = false, .error = "overview already open"};
+
+        g_overviews[PMONITOR->m_id] = std::make_unique<COverview>(PMONITOR->m_activeWorkspace, true, args[1] == "swish" ? 1 : 0);
         return {};
     }
 
-    if (arg == "off" || arg == "close" || arg == "disable") {
-        if (g_pOverview)
-            g_pOverview->close();
+    if (!POVERVIEW)
+        return {.success = false, .error = "no overview to swipe"};
+
+    if (args[0] == "update") {
+        try {
+            POVERVIEW->onSwipeUpdate(Vector2D{std::stod(args[1]), std::stod(args[2])});
+        } catch (...) { return {.success = false, .error = "invalid delta"}; }
         return {};
     }
 
-    if (g_pOverview)
+    if (args[0] == "end") {
+        POVERVIEW->onSwipeEnd();
         return {};
+    }
 
-    renderingOverview = true;
-    g_pOverview       = std::make_unique<COverview>(Desktop::focusState()->monitor()->m_activeWorkspace, false, 0);
-    renderingOverview = false;
-    return {};
+    return {.success = false, .error = "invalid swipe action"};
+}
+
+static std::string onStatsRequest(eHyprCtlOutputFormat format, std::string request) {
+    if (request.ends_with(" reset")) {
+        g_pOverviewStats->reset();
+        return "ok";
+    }
+
+    // always json, there's nothing readable about a wall of percentiles
+    return g_pOverviewStats->toJson();
 }
 
 static void failNotif(const std::string& reason) {
@@ -223,30 +336,53 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
 
     g_pAddDamageHookA = HyprlandAPI::createFunctionHook(PHANDLE, FNS[0].address, (void*)hkAddDamageA);
 
+    FNS = HyprlandAPI::findFunctionsByName(PHANDLE, "damageSurface");
+    std::erase_if(FNS, [](const auto& fn) { return !fn.demangled.contains("CHyprRenderer::damageSurface"); });
+    if (FNS.empty()) {
+        failNotif("no fns for hook CHyprRenderer::damageSurface");
+        throw std::runtime_error("[he] No fns for hook CHyprRenderer::damageSurface");
+    }
+
+    g_pDamageSurfaceHook = HyprlandAPI::createFunctionHook(PHANDLE, FNS[0].address, (void*)hkDamageSurface);
+
     bool success = g_pRenderWorkspaceHook->hook();
     success      = success && g_pAddDamageHookA->hook();
     success      = success && g_pAddDamageHookB->hook();
+    success      = success && g_pDamageSurfaceHook->hook();
 
     if (!success) {
         failNotif("Failed initializing hooks");
         throw std::runtime_error("[he] Failed initializing hooks");
     }
 
-    static auto P = Event::bus()->m_events.render.pre.listen([](PHLMONITOR) {
-        if (!g_pOverview)
-            return;
-        g_pOverview->onPreRender();
+    static auto P = Event::bus()->m_events.render.pre.listen([](PHLMONITOR pMonitor) {
+        if (const auto POVERVIEW = overviewFor(pMonitor->m_id); POVERVIEW)
+            POVERVIEW->onPreRender();
     });
 
     HyprlandAPI::addDispatcherV2(PHANDLE, "hyprexpo:expo", ::onExpoDispatcher);
+    HyprlandAPI::addDispatcherV2(PHANDLE, "hyprexpo:swipe", ::onSwipeDispatcher);
 
     HyprlandAPI::addConfigKeyword(PHANDLE, KEYWORD_EXPO_GESTURE, ::expoGestureKeyword, {true});
 
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:columns", Hyprlang::INT{3});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:rows", Hyprlang::INT{0});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:pages", Hyprlang::INT{1});
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:gap_size", Hyprlang::INT{5});
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:bg_col", Hyprlang::INT{0xFF111111});
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:workspace_method", Hyprlang::STRING{"center current"});
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:skip_empty", Hyprlang::INT{0});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:live_preview", Hyprlang::STRING{"all"});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:live_preview_rate", Hyprlang::INT{0});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:refresh_max_tiles", Hyprlang::INT{4});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:refresh_budget_ms", Hyprlang::FLOAT{0.F});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:thumbnail_scale", Hyprlang::FLOAT{1.F});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:mipmaps", Hyprlang::INT{1});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:thumbnail_format", Hyprlang::STRING{"native"});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:tile_source", Hyprlang::STRING{"render"});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:batch_render", Hyprlang::INT{0});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:background_cache", Hyprlang::INT{0});
+    HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:background_cache_interval", Hyprlang::INT{5000});
 
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprexpo:gesture_distance", Hyprlang::INT{200});
 
@@ -254,12 +390,44 @@ APICALL EXPORT PLUGIN_DESCRIPTION_INFO PLUGIN_INIT(HANDLE handle) {
     HyprlandAPI::addConfigValue(PHANDLE, "plugin:hyprswish:gesture_distance", Hyprlang::INT{200});
     HyprlandAPI::reloadConfig();
 
+    // the pool asks the tile compositor whether the atlas is usable
+    g_pTileCompositor  = std::make_unique<CTileCompositor>();
+    g_pFramebufferPool = std::make_unique<CFramebufferPool>();
+    for (auto const& m : g_pCompositor->m_monitors) {
+        g_pFramebufferPool->prewarm(m);
+    }
+
+    g_pThumbnailCache = std::make_unique<CThumbnailCache>();
+    g_pOverviewStats  = std::make_unique<COverviewStats>();
+    g_pWorkspaceIndex = std::make_unique<CWorkspaceIndex>();
+
+    HyprlandAPI::registerHyprCtlCommand(PHANDLE, SHyprCtlCommand{.name = "hyprexpo", .exact = false, .fn = ::onStatsRequest});
+
+    static auto PMONITORADDED = Event::bus()->m_events.monitor.added.listen([](PHLMONITOR pMonitor) {
+        if (g_pFramebufferPool)
+            g_pFramebufferPool->prewarm(pMonitor);
+    });
+
+    static auto PMONITORREMOVED = Event::bus()->m_events.monitor.removed.listen([](PHLMONITOR pMonitor) {
+        g_overviews.erase(pMonitor->m_id);
+
+        if (g_pFramebufferPool)
+            g_pFramebufferPool->trim();
+    });
+
     return {"hyprexpo", "A plugin for an overview and swipe", "Ali Emre Senel", "2.0"};
 }
 
 APICALL EXPORT void PLUGIN_EXIT() {
     g_pHyprRenderer->m_renderPass.removeAllOfType("COverviewPassElement");
 
+    g_overviews.clear();
+    g_pThumbnailCache.reset();
+    g_pTileCompositor.reset();
+    g_pOverviewStats.reset();
+    g_pWorkspaceIndex.reset();
+    g_pFramebufferPool.reset();
+
     g_unloading = true;
 
     g_pConfigManager->reload(); // we need to reload now to clear all the gestures
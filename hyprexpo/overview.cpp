@@ -3,8 +3,10 @@
 #include "src/plugins/PluginAPI.hpp"
 #include "src/render/OpenGL.hpp"
 #include <algorithm>
+#include <cmath>
 #include <any>
 #include <cstddef>
+#include <drm_fourcc.h>
 #include <hyprlang.hpp>
 #define private public
 #include <hyprland/src/render/Renderer.hpp>
@@ -15,40 +17,141 @@
 #include <hyprland/src/managers/cursor/CursorShapeOverrideController.hpp>
 #include <hyprland/src/managers/animation/DesktopAnimationManager.hpp>
 #include <hyprland/src/managers/input/InputManager.hpp>
+#include <hyprland/src/managers/eventLoop/EventLoopManager.hpp>
 #include <hyprland/src/helpers/time/Time.hpp>
+#include <hyprland/src/helpers/Format.hpp>
 #include <hyprland/src/desktop/state/FocusState.hpp>
+#include <hyprland/src/desktop/view/Window.hpp>
+#include <hyprland/src/desktop/view/LayerSurface.hpp>
+#include <hyprland/src/desktop/view/WLSurface.hpp>
+#include <hyprland/src/desktop/view/Subsurface.hpp>
+#include <hyprland/src/desktop/view/Popup.hpp>
+#include <hyprland/src/protocols/core/Compositor.hpp>
+#include <hyprland/src/protocols/XDGShell.hpp>
 #undef private
 #include "OverviewPassElement.hpp"
+#include "FramebufferPool.hpp"
+#include "ThumbnailCache.hpp"
+#include "TileCompositor.hpp"
+#include "OverviewStats.hpp"
+#include "WorkspaceIndex.hpp"
+
+static int maxTextureSize() {
+    static GLint size = 0;
+
+    if (size <= 0) {
+        g_pHyprRenderer->makeEGLCurrent();
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &size);
+    }
 
-static void damageMonitor(WP<Hyprutils::Animation::CBaseAnimatedVariable> thisptr) {
-    g_pOverview->damage();
+    return size;
 }
 
-static void removeOverview(WP<Hyprutils::Animation::CBaseAnimatedVariable> thisptr) {
-    g_pOverview.reset();
+// what a wheel notch adds up to in axis events
+constexpr double PAGE_SCROLL_STEP = 15.0;
+
+// a released swipe is carried on at its velocity for this long to see where it would end up
+constexpr float SWIPE_PROJECTION_S = 0.15F;
+// fingers resting this long before lifting mean there's no fling
+constexpr auto  SWIPE_IDLE = std::chrono::milliseconds(100);
+
+void COverview::blitFramebuffer(CFramebuffer& from, const CBox& src, CFramebuffer& to, const CBox& dst) {
+    GLint prevFB = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFB);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, from.getFBID());
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, to.getFBID());
+    glBlitFramebuffer(src.x, src.y, src.x + src.w, src.y + src.h, dst.x, dst.y, dst.x + dst.w, dst.y + dst.h, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, prevFB);
+}
+
+void COverview::updateMipmaps(CFramebuffer& fb) {
+    static auto* const* PMIPMAPS = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:mipmaps")->getDataStaticPtr();
+
+    const auto          TEX = fb.getTexture();
+    if (!TEX)
+        return;
+
+    if (!**PMIPMAPS) {
+        TEX->m_minFilter = GL_LINEAR;
+        return;
+    }
+
+    GLint prevTexture = 0;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &prevTexture);
+
+    glBindTexture(GL_TEXTURE_2D, TEX->m_texID);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, prevTexture);
+
+    TEX->m_minFilter = GL_LINEAR_MIPMAP_LINEAR;
 }
 
 COverview::~COverview() {
+    // hand everything back, the next session will want the same buffers. Thumbnails we just rendered make
+    // a good start for it too.
+    const auto PMONITOR = pMonitor.lock();
+
+    g_pEventLoopManager->removeTimer(wakeTimer);
+
     g_pHyprRenderer->makeEGLCurrent();
-    images.clear(); // otherwise we get a vram leak
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        auto& image = images[i];
+
+        // the cache keeps thumbnails one per fb, copy them out of the atlas
+        if (PMONITOR && image.pWorkspace && image.rendered && image.inAtlas && atlasFB && g_pThumbnailCache->enabled()) {
+            image.fb = g_pFramebufferPool->acquire(thumbnailSize(), atlasFB->m_drmFormat);
+            blitFramebuffer(*atlasFB, atlasSlot(i), *image.fb, {{}, image.fb->m_size});
+        }
+
+        if (PMONITOR && image.pWorkspace && image.rendered)
+            g_pThumbnailCache->store(PMONITOR, image.workspaceID, image.fb);
+        else
+            g_pFramebufferPool->release(image.fb);
+    }
+    g_pFramebufferPool->release(atlasFB);
+    g_pFramebufferPool->release(scratchFB);
+    g_pFramebufferPool->trim();
+    g_pThumbnailCache->onOverviewClosed();
+
+    images.clear();
 
     Cursor::overrideController->unsetOverride(Cursor::CURSOR_OVERRIDE_UNKNOWN);
     g_pHyprOpenGL->markBlurDirtyForMonitor(pMonitor.lock());
+
+    // nothing is left to flush pending damage, and the workspace has to replace us on screen
+    if (PMONITOR) {
+        blockDamageReporting = true;
+        g_pHyprRenderer->damageMonitor(PMONITOR);
+        blockDamageReporting = false;
+    }
 }
 
 COverview::COverview(PHLWORKSPACE startedOn_, bool swipe_, int type_) : startedOn(startedOn_), swipe(swipe_), type(type_) {
-    const auto PMONITOR = Desktop::focusState()->monitor();
+    g_pOverviewStats->onOverviewOpened();
+    openedAt = Time::steadyNow();
+
+    wakeTimer = makeShared<CEventLoopTimer>(std::nullopt, [this](SP<CEventLoopTimer> self, void* data) { requestFrame(); }, nullptr);
+    g_pEventLoopManager->addTimer(wakeTimer);
+
+    const auto PMONITOR = startedOn->m_monitor.lock();
     pMonitor            = PMONITOR;
+    monitorID           = PMONITOR->m_id;
 
-    static auto* const* PCOLUMNS = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:columns")->getDataStaticPtr();
-    static auto* const* PGAPS    = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:gap_size")->getDataStaticPtr();
-    static auto* const* PCOL     = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:bg_col")->getDataStaticPtr();
-    static auto* const* PSKIP    = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:skip_empty")->getDataStaticPtr();
-    static auto const*  PMETHOD  = (Hyprlang::STRING const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:workspace_method")->getDataStaticPtr();
+    static auto* const* PCOL    = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:bg_col")->getDataStaticPtr();
+    static auto* const* PSKIP   = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:skip_empty")->getDataStaticPtr();
+    static auto const*  PMETHOD = (Hyprlang::STRING const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:workspace_method")->getDataStaticPtr();
+
+    grid     = gridConfig();
+    BG_COLOR = **PCOL;
 
-    SIDE_LENGTH = **PCOLUMNS;
-    GAP_WIDTH   = **PGAPS;
-    BG_COLOR    = **PCOL;
+    // swish pans around a single page
+    if (type == 1) {
+        grid.pages = 1;
+        g_pFramebufferPool->onSwishOpened();
+    }
 
     // process the method
     bool     methodCenter  = true;
@@ -63,150 +166,88 @@ COverview::COverview(PHLWORKSPACE startedOn_, bool swipe_, int type_) : startedO
             methodStartID = pMonitor->activeWorkspaceID();
     }
 
-    images.resize(SIDE_LENGTH * SIDE_LENGTH);
-
-    // r includes empty workspaces; m skips over them
-    std::string selector = **PSKIP ? "m" : "r";
-
-    if (methodCenter) {
-        int currentID = methodStartID;
-        int firstID   = currentID;
-
-        int backtracked = 0;
+    images.resize(grid.tilesPerPage() * grid.pages);
 
-        // Initialize tiles to WORKSPACE_INVALID; cliking one of these results
-        // in changing to "emptynm" (next empty workspace). Tiles with this id
-        // will only remain if skip_empty is on.
-        for (size_t i = 0; i < images.size(); i++) {
-            images[i].workspaceID = WORKSPACE_INVALID;
-        }
-
-        // Scan through workspaces lower than methodStartID until we wrap; count how many
-        for (size_t i = 1; i < images.size() / 2; ++i) {
-            currentID = getWorkspaceIDNameFromString(selector + "-" + std::to_string(i)).id;
-            if (currentID >= firstID)
-                break;
-
-            backtracked++;
-            firstID = currentID;
-        }
-
-        // Scan through workspaces higher than methodStartID. If using "m"
-        // (skip_empty), stop when we wrap, leaving the rest of the workspace
-        // ID's set to WORKSPACE_INVALID
-        for (size_t i = 0; i < (size_t)(SIDE_LENGTH * SIDE_LENGTH); ++i) {
-            auto& image = images[i];
-            if ((int64_t)i - backtracked < 0) {
-                currentID = getWorkspaceIDNameFromString(selector + std::to_string((int64_t)i - backtracked)).id;
-            } else {
-                currentID = getWorkspaceIDNameFromString(selector + "+" + std::to_string((int64_t)i - backtracked)).id;
-                if (i > 0 && currentID <= firstID)
-                    break;
-            }
-            image.workspaceID = currentID;
-        }
-
-    } else {
-        int currentID         = methodStartID;
-        images[0].workspaceID = currentID;
-
-        auto PWORKSPACESTART = g_pCompositor->getWorkspaceByID(currentID);
-        if (!PWORKSPACESTART)
-            PWORKSPACESTART = CWorkspace::create(currentID, pMonitor.lock(), std::to_string(currentID));
-
-        pMonitor->m_activeWorkspace = PWORKSPACESTART;
-
-        // Scan through workspaces higher than methodStartID. If using "m"
-        // (skip_empty), stop when we wrap, leaving the rest of the workspace
-        // ID's set to WORKSPACE_INVALID
-        for (size_t i = 1; i < (size_t)(SIDE_LENGTH * SIDE_LENGTH); ++i) {
-            auto& image = images[i];
-            currentID   = getWorkspaceIDNameFromString(selector + "+" + std::to_string(i)).id;
-            if (currentID <= methodStartID)
-                break;
-            image.workspaceID = currentID;
-        }
-
-        pMonitor->m_activeWorkspace = startedOn;
+    // Tiles left at WORKSPACE_INVALID send a click to "emptynm" (next empty workspace). They only
+    // remain if skip_empty is on and we ran out of workspaces.
+    for (auto& image : images) {
+        image.workspaceID = WORKSPACE_INVALID;
     }
 
-    g_pHyprRenderer->makeEGLCurrent();
+    // r walks ids including empty ones; m (skip_empty) only open workspaces, stopping at the last one
+    const bool               INCLUDEEMPTY = !**PSKIP;
+    std::vector<WORKSPACEID> ids;
 
-    Vector2D tileSize       = pMonitor->m_size / SIDE_LENGTH;
-    Vector2D tileRenderSize = (pMonitor->m_size - Vector2D{GAP_WIDTH * pMonitor->m_scale, GAP_WIDTH * pMonitor->m_scale} * (SIDE_LENGTH - 1)) / SIDE_LENGTH;
-    CBox     monbox{0, 0, tileSize.x * 2, tileSize.y * 2};
+    if (methodCenter) {
+        // as many workspaces before the start as fit into the first half of the grid
+        ids = g_pWorkspaceIndex->below(pMonitor.lock(), methodStartID, INCLUDEEMPTY, std::max<int>(images.size() / 2, 1) - 1);
+        std::ranges::reverse(ids);
+    }
 
-    if (!ENABLE_LOWRES)
-        monbox = {{0, 0}, pMonitor->m_pixelSize};
+    ids.emplace_back(methodStartID);
 
-    int          currentid = 0;
+    const auto AFTER = g_pWorkspaceIndex->above(pMonitor.lock(), methodStartID, INCLUDEEMPTY, images.size() - ids.size());
+    ids.insert(ids.end(), AFTER.begin(), AFTER.end());
 
-    PHLWORKSPACE openSpecial = PMONITOR->m_activeSpecialWorkspace;
-    if (openSpecial)
-        PMONITOR->m_activeSpecialWorkspace.reset();
+    for (size_t i = 0; i < ids.size() && i < images.size(); ++i) {
+        images[i].workspaceID = ids[i];
+    }
 
-    g_pHyprRenderer->m_bBlockSurfaceFeedback = true;
+    const Vector2D GRIDSIZE = {grid.columns, grid.rows};
+    Vector2D       tileSize = pMonitor->m_size / GRIDSIZE;
 
-    startedOn->m_visible = false;
+    int            currentid = 0;
 
-    for (size_t i = 0; i < (size_t)(SIDE_LENGTH * SIDE_LENGTH); ++i) {
+    for (size_t i = 0; i < images.size(); ++i) {
         COverview::SWorkspaceImage& image = images[i];
-        image.fb.alloc(monbox.w, monbox.h, PMONITOR->m_output->state->state().drmFormat);
 
-        CRegion fakeDamage{0, 0, INT16_MAX, INT16_MAX};
-        g_pHyprRenderer->beginRender(PMONITOR, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, &image.fb);
+        image.pWorkspace = g_pCompositor->getWorkspaceByID(image.workspaceID);
 
-        g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 1.0});
-
-        const auto PWORKSPACE = g_pCompositor->getWorkspaceByID(image.workspaceID);
-
-        if (PWORKSPACE == startedOn) {
-            currentid       = i;
-            totalSwipeDelta = (Vector2D{currentid % SIDE_LENGTH, currentid / SIDE_LENGTH}) / (SIDE_LENGTH - 1);
-        }
-
-        if (PWORKSPACE) {
-            image.pWorkspace            = PWORKSPACE;
-            PMONITOR->m_activeWorkspace = PWORKSPACE;
-            g_pDesktopAnimationManager->startAnimation(PWORKSPACE, CDesktopAnimationManager::ANIMATION_TYPE_IN, true, true);
-            PWORKSPACE->m_visible = true;
+        if (image.pWorkspace && image.pWorkspace == startedOn)
+            currentid = i;
+    }
 
-            if (PWORKSPACE == startedOn)
-                PMONITOR->m_activeSpecialWorkspace = openSpecial;
+    currentPage = pageOf(currentid);
 
-            g_pHyprRenderer->renderWorkspace(PMONITOR, PWORKSPACE, Time::steadyNow(), monbox);
+    // a single column or row has nowhere to swipe along that axis, don't divide by zero for it
+    const Vector2D GRIDPOS = gridPos(currentid);
+    totalSwipeDelta        = {grid.columns > 1 ? GRIDPOS.x / (grid.columns - 1) : 0.0, grid.rows > 1 ? GRIDPOS.y / (grid.rows - 1) : 0.0};
 
-            PWORKSPACE->m_visible = false;
-            g_pDesktopAnimationManager->startAnimation(PWORKSPACE, CDesktopAnimationManager::ANIMATION_TYPE_OUT, false, true);
+    // surface tiles are drawn straight from the clients' buffers, there's nothing to prepare
+    surfaceTiles = type == 0 && surfaceTilesConfigured();
 
-            if (PWORKSPACE == startedOn)
-                PMONITOR->m_activeSpecialWorkspace.reset();
-        } else
-            g_pHyprRenderer->renderWorkspace(PMONITOR, PWORKSPACE, Time::steadyNow(), monbox);
+    if (!surfaceTiles) {
+        // thumbnails share one texture, so the grid can be composited in a single draw
+        g_pHyprRenderer->makeEGLCurrent();
+        if (const auto ATLASSIZE = atlasSizeFor(pMonitor.lock(), grid); type == 0 && ATLASSIZE != Vector2D{} && g_pTileCompositor->ready())
+            atlasFB = g_pFramebufferPool->acquire(ATLASSIZE, thumbnailFormatFor(pMonitor.lock()));
 
-        image.box = {(i % SIDE_LENGTH) * tileRenderSize.x + (i % SIDE_LENGTH) * GAP_WIDTH, (i / SIDE_LENGTH) * tileRenderSize.y + (i / SIDE_LENGTH) * GAP_WIDTH, tileRenderSize.x,
-                     tileRenderSize.y};
+        // start from whatever the background cache has for us
+        for (size_t i = 0; i < images.size(); ++i) {
+            if ((int)i != currentid && tileResident(i))
+                restoreFromCache(i);
+        }
 
-        g_pHyprOpenGL->m_renderData.blockScreenShader = true;
-        g_pHyprRenderer->endRender();
+        // the zoom starts on the current tile filling the screen, so that's the only one we need before the first frame.
+        // Everything else is left dirty and picked up by refreshTiles over the next frames.
+        g_pHyprRenderer->m_bBlockSurfaceFeedback = true;
+        redrawID(currentid, false);
+        g_pHyprRenderer->m_bBlockSurfaceFeedback = false;
     }
 
-    g_pHyprRenderer->m_bBlockSurfaceFeedback = false;
-
-    PMONITOR->m_activeSpecialWorkspace = openSpecial;
-    PMONITOR->m_activeWorkspace        = startedOn;
-    startedOn->m_visible               = true;
-    g_pDesktopAnimationManager->startAnimation(startedOn, CDesktopAnimationManager::ANIMATION_TYPE_IN, true, true);
-
     // zoom on the current workspace.
-    // const auto& TILE = images[std::clamp(currentid, 0, SIDE_LENGTH * SIDE_LENGTH)];
     if (type == 0)
         g_pAnimationManager->createAnimation(pMonitor->m_size * pMonitor->m_size / tileSize, size, g_pConfigManager->getAnimationPropertyConfig("workspaces"), AVARDAMAGE_NONE);
     else
         g_pAnimationManager->createAnimation(1.0f, scale, g_pConfigManager->getAnimationPropertyConfig("workspaces"), AVARDAMAGE_NONE);
-    g_pAnimationManager->createAnimation((-((pMonitor->m_size / (double)SIDE_LENGTH) * Vector2D{currentid % SIDE_LENGTH, currentid / SIDE_LENGTH}) * pMonitor->m_scale) *
-                                             (pMonitor->m_size / tileSize),
-                                         pos, g_pConfigManager->getAnimationPropertyConfig("workspaces"), AVARDAMAGE_NONE);
+    g_pAnimationManager->createAnimation((-((pMonitor->m_size / GRIDSIZE) * gridPos(currentid)) * pMonitor->m_scale) * (pMonitor->m_size / tileSize), pos,
+                                         g_pConfigManager->getAnimationPropertyConfig("workspaces"), AVARDAMAGE_NONE);
+
+    // pos and size tick together, the frame only has to hear about it once
+    auto damageMonitor = [this](auto) {
+        layoutChanged = true;
+        damage();
+    };
 
     pos->setUpdateCallback(damageMonitor);
     if (type == 0)
@@ -218,34 +259,36 @@ COverview::COverview(PHLWORKSPACE startedOn_, bool swipe_, int type_) : startedO
         *size = pMonitor->m_size;
         *pos  = {0, 0};
 
-        size->setCallbackOnEnd([this](auto) { redrawAll(true); });
+        size->setCallbackOnEnd([this](auto) { invalidateAll(); });
     }
 
     openedID = currentid;
 
     Cursor::overrideController->setOverride("left_ptr", Cursor::CURSOR_OVERRIDE_UNKNOWN);
 
+    updateLayout();
+
     lastMousePosLocal = g_pInputManager->getMouseCoordsInternal() - pMonitor->m_position;
+    updateHover();
 
+    // every monitor's overview sees all input, only the one under the cursor takes it
     auto onCursorMove = [this](Event::SCallbackInfo& info) {
-        if (closing)
+        if (closing || !cursorOnMonitor())
             return;
 
         info.cancelled    = true;
         lastMousePosLocal = g_pInputManager->getMouseCoordsInternal() - pMonitor->m_position;
+
+        updateHover();
     };
 
     auto onCursorSelect = [this](Event::SCallbackInfo& info) {
-        if (closing)
+        if (closing || !cursorOnMonitor())
             return;
 
         info.cancelled = true;
 
-        // get tile x,y
-        int x = lastMousePosLocal.x / pMonitor->m_size.x * SIDE_LENGTH;
-        int y = lastMousePosLocal.y / pMonitor->m_size.y * SIDE_LENGTH;
-
-        closeOnID = x + y * SIDE_LENGTH;
+        closeOnID = layout.tileAt(lastMousePosLocal);
 
         close();
     };
@@ -255,16 +298,215 @@ COverview::COverview(PHLWORKSPACE startedOn_, bool swipe_, int type_) : startedO
 
     mouseButtonHook = Event::bus()->m_events.input.mouse.button.listen([onCursorSelect](IPointer::SButtonEvent, Event::SCallbackInfo& info) { onCursorSelect(info); });
     touchDownHook   = Event::bus()->m_events.input.touch.down.listen([onCursorSelect](ITouch::SDownEvent, Event::SCallbackInfo& info) { onCursorSelect(info); });
+
+    // scrolling flips pages, a wheel notch at a time
+    mouseAxisHook = Event::bus()->m_events.input.mouse.axis.listen([this](IPointer::SAxisEvent e, Event::SCallbackInfo& info) {
+        if (closing || m_isSwiping || grid.pages <= 1 || !cursorOnMonitor())
+            return;
+
+        info.cancelled = true;
+
+        pageScroll += e.delta;
+        if (std::abs(pageScroll) < PAGE_SCROLL_STEP)
+            return;
+
+        changePage(pageScroll > 0 ? 1 : -1);
+        pageScroll = 0;
+    });
+}
+
+bool COverview::cursorOnMonitor() {
+    return g_pCompositor->getMonitorFromVector(g_pInputManager->getMouseCoordsInternal()) == pMonitor;
 }
 
 void COverview::selectHoveredWorkspace() {
     if (closing)
         return;
 
-    // get tile x,y
-    int x     = lastMousePosLocal.x / pMonitor->m_size.x * SIDE_LENGTH;
-    int y     = lastMousePosLocal.y / pMonitor->m_size.y * SIDE_LENGTH;
-    closeOnID = x + y * SIDE_LENGTH;
+    closeOnID = layout.tileAt(lastMousePosLocal);
+}
+
+void COverview::changePage(int delta) {
+    const int PAGE = std::clamp(currentPage + delta, 0, grid.pages - 1);
+
+    if (closing || PAGE == currentPage)
+        return;
+
+    currentPage = PAGE;
+
+    // pages that fell out of range give their buffers back, their atlas slots now belong to the new neighbour
+    for (size_t i = 0; i < images.size(); ++i) {
+        auto& image = images[i];
+
+        if (tileResident(i)) {
+            if (!image.rendered && image.pWorkspace)
+                restoreFromCache(i);
+            continue;
+        }
+
+        g_pFramebufferPool->release(image.fb);
+        image.fb.reset();
+        image.inAtlas  = false;
+        image.rendered = false;
+        image.dirty    = true;
+    }
+
+    updateLayout();
+    updateHover();
+    damage();
+}
+
+bool COverview::restoreFromCache(int id) {
+    auto& image = images[id];
+    if (!image.pWorkspace)
+        return false;
+
+    image.fb       = g_pThumbnailCache->take(pMonitor.lock(), image.workspaceID, thumbnailSize());
+    image.rendered = !!image.fb;
+
+    if (image.fb && atlasFB) {
+        blitFramebuffer(*image.fb, {{}, image.fb->m_size}, *atlasFB, atlasSlot(id));
+        g_pFramebufferPool->release(image.fb);
+        image.fb.reset();
+        image.inAtlas = true;
+    }
+
+    return image.rendered;
+}
+
+COverview::SGridConfig COverview::gridConfig() {
+    static auto* const* PCOLUMNS = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:columns")->getDataStaticPtr();
+    static auto* const* PROWS    = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:rows")->getDataStaticPtr();
+    static auto* const* PPAGES   = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:pages")->getDataStaticPtr();
+    static auto* const* PGAPS    = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:gap_size")->getDataStaticPtr();
+
+    const int           COLUMNS = std::max<int>(**PCOLUMNS, 1);
+
+    // rows = 0 keeps the grid square
+    return SGridConfig{.columns = COLUMNS, .rows = **PROWS > 0 ? (int)**PROWS : COLUMNS, .pages = std::max<int>(**PPAGES, 1), .gaps = (int)**PGAPS};
+}
+
+Vector2D COverview::thumbnailSizeFor(PHLMONITOR pMonitor, const SGridConfig& grid) {
+    static auto* const* PSCALE = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:thumbnail_scale")->getDataStaticPtr();
+
+    if (**PSCALE <= 0.F || grid.columns <= 0 || grid.rows <= 0)
+        return pMonitor->m_pixelSize;
+
+    const Vector2D GRIDSIZE       = {grid.columns, grid.rows};
+    const Vector2D tileRenderSize = (pMonitor->m_size - Vector2D{grid.gaps, grid.gaps} * (GRIDSIZE - Vector2D{1, 1})) / GRIDSIZE;
+    const Vector2D SIZE           = (tileRenderSize * pMonitor->m_scale * **PSCALE).round();
+
+    // a row of thumbnails, and the resident pages stacked on top of each other, have to fit into one texture
+    const Vector2D MAXSIZE = (Vector2D{maxTextureSize(), maxTextureSize()} / Vector2D{grid.columns, grid.rows * grid.residentPages()}).floor();
+
+    return Vector2D{std::clamp(SIZE.x, 1.0, std::min(pMonitor->m_pixelSize.x, MAXSIZE.x)), std::clamp(SIZE.y, 1.0, std::min(pMonitor->m_pixelSize.y, MAXSIZE.y))};
+}
+
+Vector2D COverview::atlasSizeFor(PHLMONITOR pMonitor, const SGridConfig& grid) {
+    const Vector2D THUMBSIZE = thumbnailSizeFor(pMonitor, grid);
+
+    if (grid.columns <= 0 || THUMBSIZE == pMonitor->m_pixelSize)
+        return {};
+
+    return THUMBSIZE * Vector2D{grid.columns, grid.rows * grid.residentPages()};
+}
+
+uint32_t COverview::thumbnailFormatFor(PHLMONITOR pMonitor) {
+    static auto const* PFORMAT = (Hyprlang::STRING const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:thumbnail_format")->getDataStaticPtr();
+
+    const auto         NATIVE = pMonitor->m_output->state->state().drmFormat;
+    const std::string  FORMAT = *PFORMAT;
+
+    uint32_t           wanted = NATIVE;
+    if (FORMAT == "rgba8")
+        wanted = DRM_FORMAT_XBGR8888;
+    else if (FORMAT == "rgb565")
+        wanted = DRM_FORMAT_RGB565;
+
+    // tiles are rendered in the monitor's encoding and only lose depth here, a format at least as
+    // wide as the native one would cost the same and just add a conversion to every blit
+    const auto NATIVEINFO = NFormatUtils::getPixelFormatFromDRM(NATIVE);
+    const auto WANTEDINFO = NFormatUtils::getPixelFormatFromDRM(wanted);
+    if (!NATIVEINFO || !WANTEDINFO || WANTEDINFO->bytesPerBlock >= NATIVEINFO->bytesPerBlock)
+        return NATIVE;
+
+    return wanted;
+}
+
+uint32_t COverview::tileFormatFor(PHLMONITOR pMonitor, const Vector2D& size) {
+    if (size == pMonitor->m_pixelSize)
+        return pMonitor->m_output->state->state().drmFormat;
+
+    return thumbnailFormatFor(pMonitor);
+}
+
+Vector2D COverview::thumbnailSize() {
+    // swish never shows less than most of a workspace
+    if (type == 1)
+        return pMonitor->m_pixelSize;
+
+    return thumbnailSizeFor(pMonitor.lock(), grid);
+}
+
+// queues pWorkspace into the current render pass at geometry, pretending it's the active one for the duration
+static void renderWorkspaceAt(PHLMONITOR pMonitor, PHLWORKSPACE pWorkspace, PHLWORKSPACE activeWorkspace, PHLWORKSPACE openSpecial, const CBox& geometry) {
+    if (!pWorkspace) {
+        g_pHyprRenderer->renderWorkspace(pMonitor, pWorkspace, Time::steadyNow(), geometry);
+        return;
+    }
+
+    pMonitor->m_activeWorkspace = pWorkspace;
+    g_pDesktopAnimationManager->startAnimation(pWorkspace, CDesktopAnimationManager::ANIMATION_TYPE_IN, true, true);
+    pWorkspace->m_visible = true;
+
+    if (pWorkspace == activeWorkspace)
+        pMonitor->m_activeSpecialWorkspace = openSpecial;
+
+    g_pHyprRenderer->renderWorkspace(pMonitor, pWorkspace, Time::steadyNow(), geometry);
+
+    pWorkspace->m_visible = false;
+    g_pDesktopAnimationManager->startAnimation(pWorkspace, CDesktopAnimationManager::ANIMATION_TYPE_OUT, false, true);
+
+    if (pWorkspace == activeWorkspace)
+        pMonitor->m_activeSpecialWorkspace.reset();
+}
+
+void COverview::renderWorkspaceThumbnail(PHLMONITOR pMonitor, PHLWORKSPACE pWorkspace, PHLWORKSPACE activeWorkspace, CFramebuffer& target, const CBox& dest,
+                                         SP<CFramebuffer>& scratch) {
+    g_pHyprRenderer->makeEGLCurrent();
+
+    // the workspace is always rendered at the monitor's size, otherwise blur and friends sample the wrong
+    // places. Thumbnails get it scaled down from a shared scratch buffer afterwards.
+    const bool DIRECT = target.m_size == pMonitor->m_pixelSize && dest == CBox{{}, pMonitor->m_pixelSize};
+
+    if (!DIRECT)
+        g_pFramebufferPool->resize(scratch, pMonitor->m_pixelSize, pMonitor->m_output->state->state().drmFormat);
+
+    CBox    monbox = {{0, 0}, pMonitor->m_pixelSize};
+
+    CRegion fakeDamage{0, 0, INT16_MAX, INT16_MAX};
+    g_pHyprRenderer->beginRender(pMonitor, fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, DIRECT ? &target : scratch.get());
+
+    g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 1.0});
+
+    PHLWORKSPACE openSpecial = pMonitor->m_activeSpecialWorkspace;
+    if (openSpecial)
+        pMonitor->m_activeSpecialWorkspace.reset();
+
+    activeWorkspace->m_visible = false;
+
+    renderWorkspaceAt(pMonitor, pWorkspace, activeWorkspace, openSpecial, monbox);
+
+    g_pHyprOpenGL->m_renderData.blockScreenShader = true;
+    g_pHyprRenderer->endRender();
+
+    if (!DIRECT)
+        blitFramebuffer(*scratch, {{}, scratch->m_size}, target, dest);
+
+    pMonitor->m_activeSpecialWorkspace = openSpecial;
+    pMonitor->m_activeWorkspace        = activeWorkspace;
+    activeWorkspace->m_visible         = true;
+    g_pDesktopAnimationManager->startAnimation(activeWorkspace, CDesktopAnimationManager::ANIMATION_TYPE_IN, true, true);
 }
 
 void COverview::redrawID(int id, bool forcelowres) {
@@ -275,116 +517,449 @@ void COverview::redrawID(int id, bool forcelowres) {
 
     blockOverviewRendering = true;
 
-    g_pHyprRenderer->makeEGLCurrent();
+    id = std::clamp<int>(id, 0, images.size() - 1);
 
-    id = std::clamp(id, 0, SIDE_LENGTH * SIDE_LENGTH);
+    auto& image = images[id];
 
-    Vector2D tileSize       = pMonitor->m_size / SIDE_LENGTH;
-    Vector2D tileRenderSize = (pMonitor->m_size - Vector2D{GAP_WIDTH, GAP_WIDTH} * (SIDE_LENGTH - 1)) / SIDE_LENGTH;
-    CBox     monbox{0, 0, tileSize.x * 2, tileSize.y * 2};
+    // clients on tiles that won't be refreshed anyway needn't be told to draw their next frame
+    const bool PREVBLOCK                     = g_pHyprRenderer->m_bBlockSurfaceFeedback;
+    g_pHyprRenderer->m_bBlockSurfaceFeedback = PREVBLOCK || !shouldRefreshLive(id);
 
-    if (!forcelowres || !ENABLE_LOWRES)
-        monbox = {{0, 0}, pMonitor->m_pixelSize};
+    const auto START    = Time::steadyNow();
+    const auto GPUTIMER = g_pOverviewStats->beginGpuTimer();
 
-    auto& image = images[id];
+    if (forcelowres && atlasFB) {
+        renderWorkspaceThumbnail(pMonitor.lock(), image.pWorkspace, startedOn, *atlasFB, atlasSlot(id), scratchFB);
 
-    if (image.fb.m_size != monbox.size()) {
-        image.fb.release();
-        image.fb.alloc(monbox.w, monbox.h, pMonitor->m_output->state->state().drmFormat);
+        // anything older than the atlas slot can go
+        g_pFramebufferPool->release(image.fb);
+        image.fb.reset();
+        image.inAtlas = true;
+    } else {
+        const auto SIZE = forcelowres ? thumbnailSize() : pMonitor->m_pixelSize;
+
+        g_pFramebufferPool->resize(image.fb, SIZE, tileFormatFor(pMonitor.lock(), SIZE));
+        renderWorkspaceThumbnail(pMonitor.lock(), image.pWorkspace, startedOn, *image.fb, {{}, SIZE}, scratchFB);
+        updateMipmaps(*image.fb);
+        image.inAtlas = false;
     }
 
-    CRegion fakeDamage{0, 0, INT16_MAX, INT16_MAX};
-    g_pHyprRenderer->beginRender(pMonitor.lock(), fakeDamage, RENDER_MODE_FULL_FAKE, nullptr, &image.fb);
+    g_pOverviewStats->endGpuTimer(GPUTIMER, COverviewStats::SERIES_TILE_REDRAW_GPU);
+    g_pOverviewStats->push(COverviewStats::SERIES_TILE_REDRAW_CPU, std::chrono::duration<float, std::milli>(Time::steadyNow() - START).count());
 
-    g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 1.0});
+    g_pHyprRenderer->m_bBlockSurfaceFeedback = PREVBLOCK;
 
-    const auto   PWORKSPACE = image.pWorkspace;
+    image.dirty    = false;
+    image.rendered = true;
 
-    PHLWORKSPACE openSpecial = pMonitor->m_activeSpecialWorkspace;
+    blockOverviewRendering = false;
+}
+
+bool COverview::canBatchRender() {
+    static auto* const* PBATCH = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:batch_render")->getDataStaticPtr();
+
+    // the whole atlas has to fit in the monitor's viewport
+    return **PBATCH && atlasFB && atlasFB->m_size.x <= pMonitor->m_pixelSize.x && atlasFB->m_size.y <= pMonitor->m_pixelSize.y;
+}
+
+void COverview::renderAtlasBatch(const std::vector<int>& ids) {
+    if (ids.empty())
+        return;
+
+    if (pMonitor->m_activeWorkspace != startedOn && !closing) {
+        // likely user changed.
+        onWorkspaceChange();
+    }
+
+    blockOverviewRendering = true;
+
+    const auto PMONITOR = pMonitor.lock();
+
+    g_pHyprRenderer->makeEGLCurrent();
+
+    PHLWORKSPACE openSpecial = PMONITOR->m_activeSpecialWorkspace;
     if (openSpecial)
-        pMonitor->m_activeSpecialWorkspace.reset();
+        PMONITOR->m_activeSpecialWorkspace.reset();
 
     startedOn->m_visible = false;
 
-    if (PWORKSPACE) {
-        pMonitor->m_activeWorkspace = PWORKSPACE;
-        g_pDesktopAnimationManager->startAnimation(PWORKSPACE, CDesktopAnimationManager::ANIMATION_TYPE_IN, true, true);
-        PWORKSPACE->m_visible = true;
+    const auto START     = Time::steadyNow();
+    const auto GPUTIMER  = g_pOverviewStats->beginGpuTimer();
+    const bool PREVBLOCK = g_pHyprRenderer->m_bBlockSurfaceFeedback;
+
+    // every tile is scaled straight into its slot, no scratch render. Each gets a pass damaged only there:
+    // elements are scissored to the pass damage, a clip set in between them doesn't survive their draws.
+    for (const int ID : ids) {
+        const CBox SLOT = atlasSlot(ID);
+        CRegion    damage{SLOT};
 
-        if (PWORKSPACE == startedOn)
-            pMonitor->m_activeSpecialWorkspace = openSpecial;
+        g_pHyprRenderer->m_bBlockSurfaceFeedback = PREVBLOCK || !shouldRefreshLive(ID);
 
-        g_pHyprRenderer->renderWorkspace(pMonitor.lock(), PWORKSPACE, Time::steadyNow(), monbox);
+        g_pHyprRenderer->beginRender(PMONITOR, damage, RENDER_MODE_FULL_FAKE, nullptr, atlasFB.get());
+        g_pHyprOpenGL->clear(CHyprColor{0, 0, 0, 1.0});
 
-        PWORKSPACE->m_visible = false;
-        g_pDesktopAnimationManager->startAnimation(PWORKSPACE, CDesktopAnimationManager::ANIMATION_TYPE_OUT, false, true);
+        renderWorkspaceAt(PMONITOR, images[ID].pWorkspace, startedOn, openSpecial, SLOT);
 
-        if (PWORKSPACE == startedOn)
-            pMonitor->m_activeSpecialWorkspace.reset();
-    } else
-        g_pHyprRenderer->renderWorkspace(pMonitor.lock(), PWORKSPACE, Time::steadyNow(), monbox);
+        g_pHyprOpenGL->m_renderData.blockScreenShader = true;
+        g_pHyprRenderer->endRender();
+    }
 
-    g_pHyprOpenGL->m_renderData.blockScreenShader = true;
-    g_pHyprRenderer->endRender();
+    g_pHyprRenderer->m_bBlockSurfaceFeedback = PREVBLOCK;
 
-    pMonitor->m_activeSpecialWorkspace = openSpecial;
-    pMonitor->m_activeWorkspace        = startedOn;
+    PMONITOR->m_activeSpecialWorkspace = openSpecial;
+    PMONITOR->m_activeWorkspace        = startedOn;
     startedOn->m_visible               = true;
     g_pDesktopAnimationManager->startAnimation(startedOn, CDesktopAnimationManager::ANIMATION_TYPE_IN, true, true);
 
+    // per tile figures for the batch are its share of the whole
+    g_pOverviewStats->endGpuTimer(GPUTIMER, COverviewStats::SERIES_TILE_REDRAW_GPU, ids.size());
+    const float CPUMS = std::chrono::duration<float, std::milli>(Time::steadyNow() - START).count() / ids.size();
+
+    for (const int ID : ids) {
+        g_pOverviewStats->push(COverviewStats::SERIES_TILE_REDRAW_CPU, CPUMS);
+
+        auto& image = images[ID];
+
+        g_pFramebufferPool->release(image.fb);
+        image.fb.reset();
+        image.inAtlas  = true;
+        image.dirty    = false;
+        image.rendered = true;
+    }
+
     blockOverviewRendering = false;
 }
 
-void COverview::redrawAll(bool forcelowres) {
-    for (size_t i = 0; i < (size_t)(SIDE_LENGTH * SIDE_LENGTH); ++i) {
-        redrawID(i, forcelowres);
+void COverview::redrawForClose(int id) {
+    if (surfaceTiles)
+        return;
+
+    // only the tile we zoom into ends up filling the screen. The rest shrink out of view and keep what they show,
+    // unless they'd show a placeholder on the way.
+    redrawID(id, false);
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        if ((int)i != id && !images[i].rendered && tileResident(i) && tileVisible(i))
+            redrawID(i, true);
     }
 }
 
-void COverview::redrawAllValid(bool forcelowres) {
-    for (size_t i = 0; i < (size_t)(SIDE_LENGTH * SIDE_LENGTH); ++i) {
-        if (images[i].pWorkspace)
-            redrawID(i, forcelowres);
+bool COverview::shouldRefreshLive(int id) {
+    static auto const* PLIVE = (Hyprlang::STRING const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:live_preview")->getDataStaticPtr();
+
+    const std::string_view LIVE = *PLIVE;
+
+    if (LIVE == "none")
+        return false;
+    if (LIVE == "hovered")
+        return id == hoveredID;
+    if (LIVE == "current")
+        return id == openedID;
+
+    return true;
+}
+
+void COverview::refreshTiles(bool forcelowres) {
+    static auto* const* PRATE     = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:live_preview_rate")->getDataStaticPtr();
+    static auto* const* PMAXTILES = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:refresh_max_tiles")->getDataStaticPtr();
+    static auto* const* PBUDGET   = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:refresh_budget_ms")->getDataStaticPtr();
+
+    const int  TILES       = images.size();
+    const auto NOW         = Time::steadyNow();
+    const auto MININTERVAL = **PRATE > 0 ? std::chrono::microseconds(1000000 / **PRATE) : std::chrono::microseconds(0);
+
+    // the tile we are zooming towards stays live no matter the policy
+    const bool ZOOMING  = closing || m_isSwiping || (type == 0 && size->isBeingAnimated());
+    const int  TARGETID = closing ? (closeOnID == -1 ? hoveredID : closeOnID) : openedID;
+
+    // more work than fit into this frame, and when the next rate limited tile may refresh
+    bool            pending = false;
+    Time::steady_tp nextDue = Time::steady_tp::max();
+
+    auto wants = [&](int id) {
+        if (id < 0 || id >= TILES || !images[id].dirty || !tileResident(id))
+            return false;
+
+        // off-screen tiles stay dirty until they scroll into view. The neighbouring pages get a first
+        // render ahead of time though, so flipping to one doesn't show placeholders.
+        if (!tileVisible(id)) {
+            if (images[id].rendered)
+                return false;
+            // swish only ever needs the next tile or two in the direction it is heading
+            if (type == 1)
+                return inSwishPrefetch(id);
+            return !ZOOMING && pageOf(id) != currentPage;
+        }
+
+        // never rendered yet, still showing the placeholder
+        if (!images[id].rendered)
+            return true;
+
+        if (!images[id].pWorkspace)
+            return false;
+
+        if (!shouldRefreshLive(id) && !(ZOOMING && id == TARGETID))
+            return false;
+
+        if (NOW - images[id].lastRefresh < MININTERVAL) {
+            nextDue = std::min(nextDue, images[id].lastRefresh + MININTERVAL);
+            return false;
+        }
+
+        return true;
+    };
+
+    // only the current page and its neighbours are ever looked at
+    const int FIRST    = std::max(currentPage - 1, 0) * grid.tilesPerPage();
+    const int RESIDENT = std::min((currentPage + 2) * grid.tilesPerPage(), TILES) - FIRST;
+
+    // hovered first, then the zoom target, then everything else on screen round-robin, then the prefetch
+    std::vector<int> order, prefetch;
+    order.reserve(RESIDENT);
+    if (wants(hoveredID))
+        order.emplace_back(hoveredID);
+    if (TARGETID != hoveredID && wants(TARGETID))
+        order.emplace_back(TARGETID);
+    for (int i = 0; i < RESIDENT; ++i) {
+        const int ID = FIRST + (refreshCursor + i) % RESIDENT;
+        if (ID == hoveredID || ID == TARGETID || !wants(ID))
+            continue;
+        (tileVisible(ID) ? order : prefetch).emplace_back(ID);
+    }
+    order.insert(order.end(), prefetch.begin(), prefetch.end());
+
+    // with batching on, thumbnails are collected and rendered together at the end
+    const bool       BATCH = forcelowres && canBatchRender();
+    std::vector<int> batch;
+
+    size_t           refreshed = 0;
+    for (const int ID : order) {
+        if (**PMAXTILES > 0 && refreshed >= (size_t)**PMAXTILES) {
+            pending = true;
+            break;
+        }
+
+        if (**PBUDGET > 0 && std::chrono::duration<float, std::milli>(Time::steadyNow() - NOW).count() >= **PBUDGET) {
+            pending = true;
+            break;
+        }
+
+        const bool LOWRES = forcelowres && !(ZOOMING && ID == TARGETID);
+
+        // surface tiles always show the latest buffers, they only need compositing again
+        if (surfaceTiles) {
+            images[ID].dirty    = false;
+            images[ID].rendered = true;
+            damageTile(ID);
+        } else if (BATCH && LOWRES)
+            batch.emplace_back(ID);
+        else {
+            redrawID(ID, LOWRES);
+            damageTile(ID);
+        }
+
+        images[ID].lastRefresh = NOW;
+        refreshed++;
+
+        if (ID != hoveredID && ID != TARGETID)
+            refreshCursor = (ID - FIRST + 1) % RESIDENT;
+    }
+
+    renderAtlasBatch(batch);
+    for (const int ID : batch) {
+        damageTile(ID);
     }
+
+    g_pOverviewStats->push(COverviewStats::SERIES_TILES_PER_FRAME, refreshed);
+
+    // come back next frame for whatever didn't fit. Rate limited tiles are waited for with a timer, a frame
+    // each in between would keep the gpu busy doing nothing.
+    if (pending)
+        g_pCompositor->scheduleFrameForMonitor(pMonitor.lock());
+    else if (nextDue != Time::steady_tp::max())
+        wakeTimer->updateTimeout(std::chrono::duration_cast<std::chrono::steady_clock::duration>(nextDue - NOW));
+
+    workPending = pending || nextDue != Time::steady_tp::max();
+}
+
+void COverview::invalidateAll() {
+    for (auto& image : images) {
+        image.dirty = true;
+    }
+
+    requestFrame();
+}
+
+int COverview::tileForWorkspace(const PHLWORKSPACE& ws) {
+    if (!ws)
+        return -1;
+
+    for (size_t i = 0; i < images.size(); ++i) {
+        if (images[i].pWorkspace == ws)
+            return i;
+    }
+
+    return -1;
+}
+
+void COverview::markWindowDamaged(PHLWINDOW pWindow) {
+    if (pWindow->m_pinned) {
+        // pinned windows show up on every workspace
+        for (auto& image : images) {
+            image.dirty = true;
+        }
+        return;
+    }
+
+    const int ID = tileForWorkspace(pWindow->m_workspace);
+    if (ID != -1)
+        images[ID].dirty = true;
+}
+
+COverview::SDamageOwner COverview::damageOwnerOf(SP<CWLSurfaceResource> pSurface) {
+    const auto SURFACE = CWLSurface::fromResource(pSurface);
+    if (!SURFACE)
+        return {};
+
+    PHLWINDOW window;
+    PHLLS     layer;
+
+    // subsurfaces and popups belong to whatever they hang off
+    if (const auto PSUBSURFACE = SURFACE->getSubsurface(); PSUBSURFACE) {
+        window = PSUBSURFACE->m_windowParent.lock();
+        if (const auto PPOPUP = PSUBSURFACE->m_popupParent.lock(); PPOPUP) {
+            window = PPOPUP->m_windowOwner.lock();
+            layer  = PPOPUP->m_layerOwner.lock();
+        }
+    } else if (const auto PPOPUP = SURFACE->getPopup(); PPOPUP) {
+        window = PPOPUP->m_windowOwner.lock();
+        layer  = PPOPUP->m_layerOwner.lock();
+    } else {
+        window = SURFACE->getWindow();
+        layer  = SURFACE->getLayer();
+    }
+
+    if (window)
+        return {.window = window};
+
+    // background and bottom layers are drawn into every thumbnail
+    if (layer && (layer->m_layer == ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND || layer->m_layer == ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM))
+        return {.allTiles = true};
+
+    return {};
 }
 
 void COverview::damage() {
-    blockDamageReporting = true;
-    g_pHyprRenderer->damageMonitor(pMonitor.lock());
-    blockDamageReporting = false;
+    g_pOverviewStats->onDamageRequest();
+
+    fullDamagePending = true;
+    requestFrame();
 }
 
-void COverview::onDamageReported() {
-    damageDirty = true;
+void COverview::onDamageReported(const CBox& box, const SDamageOwner& owner) {
+    g_pOverviewStats->onDamageReport();
 
-    Vector2D SIZE = type == 0 ? size->value() : pMonitor->m_size * pMonitor->m_scale;
+    // our own offscreen renders report damage too, don't feed that back
+    if (blockOverviewRendering)
+        return;
 
-    Vector2D tileSize       = (SIZE / SIDE_LENGTH);
-    Vector2D tileRenderSize = (SIZE - Vector2D{GAP_WIDTH, GAP_WIDTH} * (SIDE_LENGTH - 1)) / SIDE_LENGTH;
-    // const auto& TILE           = images[std::clamp(openedID, 0, SIDE_LENGTH * SIDE_LENGTH)];
-    CBox texbox = CBox{(openedID % SIDE_LENGTH) * tileRenderSize.x + (openedID % SIDE_LENGTH) * GAP_WIDTH,
-                       (openedID / SIDE_LENGTH) * tileRenderSize.y + (openedID / SIDE_LENGTH) * GAP_WIDTH, tileRenderSize.x, tileRenderSize.y}
-                      .translate(pMonitor->m_position);
+    g_pOverviewStats->onDamageRequest();
 
-    damage();
+    if (owner.allTiles) {
+        for (auto& image : images) {
+            image.dirty = true;
+        }
+    } else if (const auto PWINDOW = owner.window.lock(); PWINDOW) {
+        markWindowDamaged(PWINDOW);
+    } else {
+        // top layers, decorations, the cursor and anything else we can't map; blame the live workspace
+        const int ID = tileForWorkspace(startedOn);
+        if (ID != -1)
+            images[ID].dirty = true;
+    }
+
+    // whatever is drawn over the grid (bars, notifications, a software cursor) changed in that spot too.
+    // Reports are monitor-local pixels, the flush wants global logical coordinates.
+    CBox global = box;
+    global.scale(1.0 / pMonitor->m_scale).translate(pMonitor->m_position).expand(1);
+    tileDamagePending.add(global);
+
+    requestFrame();
+}
+
+void COverview::requestFrame() {
+    // also set while onPreRender runs, anything requested then makes it into that frame
+    if (frameRequested)
+        return;
+
+    frameRequested = true;
+    idle           = false;
+    g_pCompositor->scheduleFrameForMonitor(pMonitor.lock());
+}
+
+void COverview::flushDamage() {
+    if (!fullDamagePending && tileDamagePending.empty())
+        return;
+
+    g_pOverviewStats->onDamageFlush();
 
     blockDamageReporting = true;
-    g_pHyprRenderer->damageBox(texbox);
+    if (fullDamagePending)
+        g_pHyprRenderer->damageMonitor(pMonitor.lock());
+    else
+        g_pHyprRenderer->damageRegion(tileDamagePending);
     blockDamageReporting = false;
-    g_pCompositor->scheduleFrameForMonitor(pMonitor.lock());
+
+    fullDamagePending = false;
+    tileDamagePending.clear();
+}
+
+bool COverview::isStatic() {
+    if (closing || m_isSwiping || pos->isBeingAnimated())
+        return false;
+
+    return type == 0 ? !size->isBeingAnimated() : !scale->isBeingAnimated();
+}
+
+void COverview::damageTile(int id) {
+    if (id < 0 || id >= (int)images.size())
+        return;
+
+    // while anything moves the whole monitor is damaged anyways
+    if (!isStatic()) {
+        damage();
+        return;
+    }
+
+    g_pOverviewStats->onDamageRequest();
+
+    CBox box = layout.logicalBox(id);
+    box.translate(pMonitor->m_position).expand(1);
+
+    tileDamagePending.add(box);
+    requestFrame();
 }
 
 void COverview::close() {
     if (closing)
         return;
-    closing = true;
 
-    const int   ID = closeOnID == -1 ? hoveredID : closeOnID;
+    const int ID = std::clamp<int>(closeOnID == -1 ? hoveredID : closeOnID, 0, images.size() - 1);
+
+    // zoom into the tile where it is, on its own page
+    changePage(pageOf(ID) - currentPage);
 
-    const auto& TILE = images[std::clamp(ID, 0, SIDE_LENGTH * SIDE_LENGTH)];
+    closing   = true;
+    closeOnID = ID;
+
+    const auto&    TILE = images[ID];
+
+    const Vector2D GRIDSIZE = {grid.columns, grid.rows};
+    Vector2D       tileSize = (pMonitor->m_size / GRIDSIZE);
+    *pos                    = (-((pMonitor->m_size / GRIDSIZE) * gridPos(ID)) * pMonitor->m_scale) * (pMonitor->m_size / tileSize);
+    // this destroys us, nothing may touch the overview after
+    auto removeOverview = [ID = monitorID](auto) { g_overviews.erase(ID); };
 
-    Vector2D    tileSize = (pMonitor->m_size / SIDE_LENGTH);
-    *pos                 = (-((pMonitor->m_size / (double)SIDE_LENGTH) * Vector2D{ID % SIDE_LENGTH, ID / SIDE_LENGTH}) * pMonitor->m_scale) * (pMonitor->m_size / tileSize);
     if (type == 0) {
         *size = pMonitor->m_size * pMonitor->m_size / tileSize;
         size->setCallbackOnEnd(removeOverview);
@@ -393,7 +968,10 @@ void COverview::close() {
         scale->setCallbackOnEnd(removeOverview);
     }
 
-    redrawAll();
+    // the gaps close with the zoom from here on
+    updateLayout();
+
+    redrawForClose(ID);
 
     if (TILE.workspaceID != pMonitor->activeWorkspaceID()) {
         pMonitor->setSpecialWorkspace(0);
@@ -419,15 +997,53 @@ void COverview::close() {
     }
 }
 
+void COverview::updateHover() {
+    const int PREVHOVERED = hoveredID;
+
+    // swish hovers whatever is in the middle of the screen
+    hoveredID = layout.tileAt(type == 0 ? lastMousePosLocal : pMonitor->m_size / 2.0);
+
+    // moving within a tile costs nothing, crossing into another only composites the old and new highlight
+    if (PREVHOVERED == hoveredID)
+        return;
+
+    damageTile(PREVHOVERED);
+    damageTile(hoveredID);
+}
+
 void COverview::onPreRender() {
-    int hoveredX =
-        type == 0 ? ((lastMousePosLocal.x - pos->value().x) / size->value().x) * SIDE_LENGTH : (((pMonitor->m_size.x / 2) - pos->value().x / scale->value()) / pMonitor->m_size.x);
-    int hoveredY =
-        type == 0 ? ((lastMousePosLocal.y - pos->value().y) / size->value().y) * SIDE_LENGTH : (((pMonitor->m_size.y / 2) - pos->value().y / scale->value()) / pMonitor->m_size.y);
-    hoveredID = hoveredX + hoveredY * SIDE_LENGTH;
+    g_pOverviewStats->onWakeup();
+
+    const auto NOW = Time::steadyNow();
+    if (lastFrameAt != Time::steady_tp{})
+        g_pOverviewStats->push(COverviewStats::SERIES_FRAME_INTERVAL, std::chrono::duration<float, std::milli>(NOW - lastFrameAt).count());
+    lastFrameAt = NOW;
+
+    // this frame takes whatever is requested until it's rendered
+    frameRequested = true;
+
+    flushSwipe();
+
+    // the tiles move under a still cursor while animating
+    if (layoutChanged) {
+        layoutChanged = false;
+        updateLayout();
+        updateHover();
+    }
+
+    refreshTiles(true);
 
-    redrawID(hoveredID, true);
-    redrawAllValid(true);
+    // everything damaged since the last frame, tiles refreshed just now included, lands in this one
+    flushDamage();
+
+    frameRequested = false;
+
+    // with nothing moving and nothing to refresh, the next frame waits for input, an animation or a client
+    idle = isStatic() && !workPending;
+
+    // waiting while idle is on purpose, it's not a slow frame
+    if (idle)
+        lastFrameAt = {};
 }
 
 void COverview::onWorkspaceChange() {
@@ -436,7 +1052,7 @@ void COverview::onWorkspaceChange() {
     else
         startedOn = pMonitor->m_activeWorkspace;
 
-    for (size_t i = 0; i < (size_t)(SIDE_LENGTH * SIDE_LENGTH); ++i) {
+    for (size_t i = 0; i < images.size(); ++i) {
         if (images[i].workspaceID != pMonitor->activeWorkspaceID())
             continue;
 
@@ -449,33 +1065,195 @@ void COverview::onWorkspaceChange() {
 }
 
 void COverview::render() {
-    g_pHyprRenderer->m_renderPass.add(makeUnique<COverviewPassElement>());
+    g_pHyprRenderer->m_renderPass.add(makeUnique<COverviewPassElement>(this));
+}
+
+void COverview::updateLayout() {
+    const Vector2D GRIDSIZE = {grid.columns, grid.rows};
+    // the gaps open up with the zoom, swish has none
+    const double   GAPSIZE  = type == 0 ? (closing ? (1.0 - size->getPercent()) : size->getPercent()) * grid.gaps : 0.0;
+    const Vector2D TILESIZE = type == 0 ? (size->value() - Vector2D{GAPSIZE, GAPSIZE} * (GRIDSIZE - Vector2D{1, 1})) / GRIDSIZE : pMonitor->m_size * scale->value();
+
+    layout.update(pMonitor.lock(), grid.columns, grid.rows, images.size(), currentPage, pos->value(), TILESIZE, GAPSIZE);
 }
 
-void COverview::fullRender() {
-    const auto GAPSIZE = type == 0 ? ((closing ? (1.0 - size->getPercent()) : size->getPercent()) * GAP_WIDTH) : 0.0f;
+bool COverview::surfaceTilesConfigured() {
+    static auto const* PSOURCE = (Hyprlang::STRING const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:tile_source")->getDataStaticPtr();
+
+    return std::string_view{*PSOURCE} == "surfaces";
+}
+
+void COverview::renderSurfaceTile(int id, const CBox& texbox, const CRegion& damage) {
+    g_pHyprOpenGL->renderRect(texbox, CHyprColor{0, 0, 0, 1.0}, {.damage = &damage});
+
+    const auto& PWORKSPACE = images[id].pWorkspace;
+    if (!PWORKSPACE)
+        return;
+
+    // the monitor, in pixels, squeezed into the tile
+    const Vector2D SCALE = Vector2D{texbox.w, texbox.h} / pMonitor->m_pixelSize;
+    const auto     NOW   = Time::steadyNow();
+    const bool     LIVE  = shouldRefreshLive(id);
+
+    // windows hanging off the monitor edge must not spill into the neighbouring tiles
+    g_pHyprOpenGL->m_renderData.clipBox = texbox;
+
+    // geometry is the part of the surface that lands on position and size, e.g. the xdg geometry of a
+    // client drawing its own shadows. Empty for all of it.
+    auto drawSurface = [&](const auto& surface, const Vector2D& position, const Vector2D& size, const CBox& geometry) {
+        const auto RESOURCE = surface ? surface->resource() : nullptr;
+        if (!RESOURCE || !RESOURCE->m_current.texture)
+            return;
+
+        // nothing else renders these clients while we're open, without frame callbacks they'd stop drawing
+        if (LIVE)
+            RESOURCE->breadthfirst([&NOW](SP<CWLSurfaceResource> s, const Vector2D&, void*) { s->frame(NOW); }, nullptr);
+
+        const Vector2D SURFACESIZE = RESOURCE->m_current.size;
+        const CBox     GEOMETRY    = geometry.empty() ? CBox{{}, SURFACESIZE} : geometry;
+        const Vector2D FIT         = GEOMETRY.w > 0 && GEOMETRY.h > 0 ? size / GEOMETRY.size() : Vector2D{1, 1};
+        const Vector2D POS         = (position - GEOMETRY.pos() * FIT - pMonitor->m_position) * pMonitor->m_scale * SCALE;
+        const Vector2D BOXSIZE     = SURFACESIZE * FIT * pMonitor->m_scale * SCALE;
+        CBox           box         = {texbox.x + POS.x, texbox.y + POS.y, BOXSIZE.x, BOXSIZE.y};
+
+        // the buffer is drawn in its own orientation and turned back onto the surface around the centre
+        const auto TRANSFORM = RESOURCE->m_current.transform;
+        const int  QUARTERS  = TRANSFORM % 4;
+        const bool FLIPPED   = TRANSFORM >= WL_OUTPUT_TRANSFORM_FLIPPED;
+        if (QUARTERS % 2 == 1)
+            box = {box.x + (box.w - box.h) / 2.0, box.y + (box.h - box.w) / 2.0, box.h, box.w};
+        box.rot = QUARTERS * M_PI / 2.0;
+
+        // a flip around the surface's vertical axis is one around the buffer's horizontal axis after a quarter turn
+        if (FLIPPED) {
+            g_pHyprOpenGL->m_renderData.primarySurfaceUVTopLeft     = QUARTERS % 2 == 1 ? Vector2D{0, 1} : Vector2D{1, 0};
+            g_pHyprOpenGL->m_renderData.primarySurfaceUVBottomRight = QUARTERS % 2 == 1 ? Vector2D{1, 0} : Vector2D{0, 1};
+        }
+
+        g_pHyprOpenGL->renderTexture(RESOURCE->m_current.texture, box.round(), {.damage = &damage, .a = 1.0f, .allowCustomUV = FLIPPED});
+
+        g_pHyprOpenGL->m_renderData.primarySurfaceUVTopLeft     = Vector2D{-1, -1};
+        g_pHyprOpenGL->m_renderData.primarySurfaceUVBottomRight = Vector2D{-1, -1};
+    };
+
+    for (const auto LAYER : {ZWLR_LAYER_SHELL_V1_LAYER_BACKGROUND, ZWLR_LAYER_SHELL_V1_LAYER_BOTTOM}) {
+        for (auto const& ls : pMonitor->m_layerSurfaceLayers[LAYER]) {
+            if (const auto PLS = ls.lock(); PLS && PLS->m_mapped)
+                drawSurface(PLS->wlSurface(), PLS->m_realPosition->value(), PLS->m_realSize->value(), CBox{});
+        }
+    }
+
+    // tiled below floating, otherwise in the compositor's stacking order
+    for (const bool FLOATING : {false, true}) {
+        for (auto const& w : g_pCompositor->m_windows) {
+            if (!w->m_isMapped || w->isHidden() || w->m_isFloating != FLOATING)
+                continue;
+            if (w->m_workspace != PWORKSPACE && !(w->m_pinned && w->m_monitor == pMonitor))
+                continue;
 
+            const CBox GEOMETRY = !w->m_isX11 && w->m_xdgSurface ? w->m_xdgSurface->m_current.geometry : CBox{};
+            drawSurface(w->wlSurface(), w->m_realPosition->value(), w->m_realSize->value(), GEOMETRY);
+        }
+    }
+
+    g_pHyprOpenGL->m_renderData.clipBox = {};
+}
+
+CBox COverview::atlasSlot(int id) {
+    // resident pages are stacked top to bottom, each page reusing the slots of the one three away
+    const Vector2D THUMBSIZE = thumbnailSize();
+    const Vector2D SLOT      = gridPos(id) + Vector2D{0, (pageOf(id) % grid.residentPages()) * grid.rows};
+    return CBox{SLOT * THUMBSIZE, THUMBSIZE};
+}
+
+int COverview::pageOf(int id) {
+    return id / grid.tilesPerPage();
+}
+
+Vector2D COverview::gridPos(int id) {
+    const int LOCAL = id % grid.tilesPerPage();
+    return Vector2D{LOCAL % grid.columns, LOCAL / grid.columns};
+}
+
+bool COverview::tileResident(int id) {
+    return std::abs(pageOf(id) - currentPage) <= 1;
+}
+
+bool COverview::inSwishPrefetch(int id) {
+    if (swipeDirection == Vector2D{} || hoveredID < 0)
+        return false;
+
+    // the ring around the centre tile, on the sides the viewport moves towards
+    const Vector2D OFFSET = gridPos(id) - gridPos(hoveredID);
+    if (std::abs(OFFSET.x) > 1 || std::abs(OFFSET.y) > 1 || OFFSET == Vector2D{})
+        return false;
+
+    return (OFFSET.x == 0 || OFFSET.x == swipeDirection.x) && (OFFSET.y == 0 || OFFSET.y == swipeDirection.y);
+}
+
+bool COverview::tileVisible(int id) {
+    // most of a zoom or swipe only has a handful of tiles on screen
+    return layout.pixelBox(id).overlaps(CBox{{}, pMonitor->m_pixelSize});
+}
+
+void COverview::fullRender(const CRegion& damage) {
     if (pMonitor->m_activeWorkspace != startedOn && !closing) {
         // likely user changed.
         onWorkspaceChange();
     }
 
-    Vector2D tileRenderSize = type == 0 ? ((size->value() - Vector2D{GAPSIZE, GAPSIZE} * (SIDE_LENGTH - 1)) / SIDE_LENGTH) : (pMonitor->m_size * scale->value());
+    const CBox MONBOX = {{}, pMonitor->m_pixelSize};
+
+    g_pOverviewStats->pollGpuTimers();
+
+    const auto START    = Time::steadyNow();
+    const auto GPUTIMER = g_pOverviewStats->beginGpuTimer();
 
+    // clear() only touches the damaged parts of the monitor
     g_pHyprOpenGL->clear(BG_COLOR.stripA());
 
-    for (size_t y = 0; y < (size_t)SIDE_LENGTH; ++y) {
-        for (size_t x = 0; x < (size_t)SIDE_LENGTH; ++x) {
-            CBox texbox = {x * tileRenderSize.x + x * GAPSIZE, y * tileRenderSize.y + y * GAPSIZE, tileRenderSize.x, tileRenderSize.y};
-            texbox.scale(pMonitor->m_scale).translate(pos->value());
-            texbox.round();
-            CRegion damage{0, 0, INT16_MAX, INT16_MAX};
-            g_pHyprOpenGL->renderTexture(images[x + y * SIDE_LENGTH].fb.getTexture(), texbox, {.damage = &damage, .a = 1.0f});
-            if (type == 0 && x + y * SIDE_LENGTH == hoveredID) {
-                auto zoomFactor = (pMonitor->m_size.x / (size->value().x / SIDE_LENGTH)) - 2.0;
-                g_pHyprOpenGL->renderRect(texbox, CHyprColor{1.0, 1.0, 1.0, lerp(0.0, 0.3, std::clamp(zoomFactor, 0.0, 1.0))}, {});
-            }
+    // nothing beyond the neighbouring pages can be on screen, or has anything to show
+    const int FIRST = std::max(currentPage - 1, 0) * grid.tilesPerPage();
+    const int LAST  = std::min<int>((currentPage + 2) * grid.tilesPerPage(), images.size());
+
+    for (int id = FIRST; id < LAST; ++id) {
+        const CBox texbox = layout.pixelBox(id);
+        if (!texbox.overlaps(MONBOX))
+            continue;
+
+        float highlight = 0.F;
+        if (type == 0 && id == hoveredID) {
+            auto zoomFactor = (pMonitor->m_size.x / (size->value().x / grid.columns)) - 2.0;
+            highlight       = lerp(0.0, 0.3, std::clamp(zoomFactor, 0.0, 1.0));
         }
+
+        // atlas tiles are batched, full size ones and placeholders are drawn as they come
+        if (images[id].inAtlas && atlasFB) {
+            g_pTileCompositor->add(texbox, atlasSlot(id), highlight);
+            continue;
+        }
+
+        if (surfaceTiles)
+            renderSurfaceTile(id, texbox, damage);
+        else if (const auto& FB = images[id].fb; FB)
+            g_pHyprOpenGL->renderTexture(FB->getTexture(), texbox, {.damage = &damage, .a = 1.0f});
+        else
+            g_pHyprOpenGL->renderRect(texbox, CHyprColor{0, 0, 0, 1.0}, {.damage = &damage});
+        if (highlight > 0.F)
+            g_pHyprOpenGL->renderRect(texbox, CHyprColor{1.0, 1.0, 1.0, highlight}, {.damage = &damage});
+    }
+
+    if (atlasFB)
+        g_pTileCompositor->flush(*atlasFB, damage);
+
+    g_pOverviewStats->endGpuTimer(GPUTIMER, COverviewStats::SERIES_COMPOSITE_GPU);
+
+    const auto NOW = Time::steadyNow();
+    g_pOverviewStats->push(COverviewStats::SERIES_COMPOSITE_CPU, std::chrono::duration<float, std::milli>(NOW - START).count());
+
+    if (!firstFrameShown) {
+        firstFrameShown = true;
+        g_pOverviewStats->push(COverviewStats::SERIES_OPEN_TO_FIRST_FRAME, std::chrono::duration<float, std::milli>(NOW - openedAt).count());
     }
 }
 
@@ -500,7 +1278,31 @@ static Vector2D clamp(const Vector2D& val, const double min, const double max) {
 }
 
 void COverview::onSwipeUpdate(Vector2D delta) {
+    static auto* const* PDISTANCE = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:gesture_distance")->getDataStaticPtr();
+
     m_isSwiping = true;
+
+    // touchpads can report several times per refresh, only the sum matters to the next frame
+    pendingSwipeDelta += delta;
+
+    // how fast the zoom progresses, smoothed over the last few events
+    const auto NOW = Time::steadyNow();
+    if (type == 0 && lastSwipeUpdate != Time::steady_tp{}) {
+        const float DT = std::max(std::chrono::duration<float>(NOW - lastSwipeUpdate).count(), 0.001F);
+        swipeVelocity  = lerp(swipeVelocity, (float)(delta.y / **PDISTANCE / DT), 0.5F);
+    }
+    lastSwipeUpdate = NOW;
+
+    requestFrame();
+}
+
+void COverview::flushSwipe() {
+    if (pendingSwipeDelta == Vector2D{})
+        return;
+
+    const Vector2D delta = pendingSwipeDelta;
+    pendingSwipeDelta    = {};
+
     if (type == 0) {
         static auto* const* PDISTANCE = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprexpo:gesture_distance")->getDataStaticPtr();
         totalSwipeDelta.y -= delta.y / (double)**PDISTANCE;
@@ -509,8 +1311,8 @@ void COverview::onSwipeUpdate(Vector2D delta) {
         const float PERC = 1.0 - totalSwipeDelta.y;
 
         const auto  focusedID = fullyOpened ? hoveredID : openedID;
-        const auto  SIZEMAX   = pMonitor->m_size * SIDE_LENGTH;
-        const auto  POSMAX    = Vector2D{focusedID % SIDE_LENGTH, focusedID / SIDE_LENGTH} * pMonitor->m_size * pMonitor->m_scale;
+        const auto  SIZEMAX   = pMonitor->m_size * Vector2D{grid.columns, grid.rows};
+        const auto  POSMAX    = gridPos(focusedID) * pMonitor->m_size * pMonitor->m_scale;
 
         const auto  SIZEMIN = pMonitor->m_size;
         const auto  POSMIN  = Vector2D{0, 0};
@@ -522,34 +1324,47 @@ void COverview::onSwipeUpdate(Vector2D delta) {
         static auto* const* PDISTANCE = (Hyprlang::INT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprswish:gesture_distance")->getDataStaticPtr();
         static auto* const* PSCALE    = (Hyprlang::FLOAT* const*)HyprlandAPI::getConfigValue(PHANDLE, "plugin:hyprswish:zoom_scale")->getDataStaticPtr();
 
+        // a positive delta pans back towards the first tile
+        swipeDirection = {delta.x < 0 ? 1 : (delta.x > 0 ? -1 : 0), delta.y < 0 ? 1 : (delta.y > 0 ? -1 : 0)};
+
         totalSwipeDelta -= delta / **PDISTANCE;
         totalSwipeDelta = clamp(totalSwipeDelta, 0.0001, 0.9999);
 
-        const auto POSMAX = (Vector2D{SIDE_LENGTH, SIDE_LENGTH} * pMonitor->m_scale * pMonitor->m_size * scale->value()) - (pMonitor->m_size * pMonitor->m_scale);
+        const auto POSMAX = (Vector2D{grid.columns, grid.rows} * pMonitor->m_scale * pMonitor->m_size * scale->value()) - (pMonitor->m_size * pMonitor->m_scale);
         const auto POSMIN = Vector2D{0, 0};
 
         pos->setValueAndWarp(lerp(POSMIN, -POSMAX, totalSwipeDelta));
-        *scale = **PSCALE;
+        if (scale->goal() != **PSCALE)
+            *scale = **PSCALE;
     }
 }
 
 void COverview::onSwipeEnd() {
+    // whatever came in since the last frame still counts
+    flushSwipe();
+
+    const float VELOCITY = Time::steadyNow() - lastSwipeUpdate > SWIPE_IDLE ? 0.F : swipeVelocity;
+    swipeVelocity        = 0;
+    lastSwipeUpdate      = {};
+
     if (type == 1) {
         close();
         return;
     }
 
     const auto SIZEMIN = pMonitor->m_size;
-    const auto SIZEMAX = pMonitor->m_size * pMonitor->m_size / (pMonitor->m_size / SIDE_LENGTH);
+    const auto SIZEMAX = pMonitor->m_size * pMonitor->m_size / (pMonitor->m_size / Vector2D{grid.columns, grid.rows});
     const auto PERC    = (size->value() - SIZEMIN).x / (SIZEMAX - SIZEMIN).x;
-    if (PERC > 0.5) {
+
+    // a quick flick finishes even if it didn't make it halfway, a slow one has to
+    if (PERC + VELOCITY * SWIPE_PROJECTION_S > 0.5) {
         close();
         return;
     }
     *size = pMonitor->m_size;
     *pos  = {0, 0};
 
-    size->setCallbackOnEnd([this](WP<Hyprutils::Animation::CBaseAnimatedVariable> thisptr) { redrawAll(true); });
+    size->setCallbackOnEnd([this](WP<Hyprutils::Animation::CBaseAnimatedVariable> thisptr) { invalidateAll(); });
 
     m_isSwiping = false;
     fullyOpened = true;
@@ -4,26 +4,34 @@
 #define WLR_USE_UNSTABLE
 
 #include "globals.hpp"
+#include "GridLayout.hpp"
 #include <hyprland/src/desktop/DesktopTypes.hpp>
 #include <hyprland/src/render/Framebuffer.hpp>
 #include <hyprland/src/helpers/AnimatedVariable.hpp>
 #include <hyprland/src/event/EventBus.hpp>
+#include <hyprland/src/helpers/time/Time.hpp>
+#include <hyprland/src/managers/eventLoop/EventLoopTimer.hpp>
+#include <algorithm>
+#include <unordered_map>
 #include <vector>
 
-// saves on resources, but is a bit broken rn with blur.
-// hyprland's fault, but cba to fix.
-constexpr bool ENABLE_LOWRES = false;
-
 class CMonitor;
+class CWLSurfaceResource;
 
 class COverview {
   public:
     COverview(PHLWORKSPACE startedOn_, bool swipe = false, int type = 0);
     ~COverview();
 
+    // which tiles a damaged surface shows up in: its window's, all of them, or with neither set the live one
+    struct SDamageOwner {
+        PHLWINDOWREF window;
+        bool         allTiles = false;
+    };
+
     void render();
     void damage();
-    void onDamageReported();
+    void onDamageReported(const CBox& box, const SDamageOwner& owner);
     void onPreRender();
 
     void onSwipeUpdate(Vector2D delta);
@@ -32,6 +40,44 @@ class COverview {
     // close without a selection
     void          close();
     void          selectHoveredWorkspace();
+    // flips by delta pages, clamped to the first and last
+    void          changePage(int delta);
+
+    // the grid as configured. Pages after the first continue to the right of it.
+    struct SGridConfig {
+        int columns = 3;
+        int rows    = 3;
+        int pages   = 1;
+        int gaps    = 5;
+
+        int tilesPerPage() const {
+            return columns * rows;
+        }
+
+        // only the current page and one either side of it hold thumbnails
+        int residentPages() const {
+            return std::min(pages, 3);
+        }
+    };
+
+    static SGridConfig gridConfig();
+    static Vector2D thumbnailSizeFor(PHLMONITOR pMonitor, const SGridConfig& grid);
+    // size of the texture holding the thumbnails of all resident pages, empty if the tiles are full size
+    static Vector2D atlasSizeFor(PHLMONITOR pMonitor, const SGridConfig& grid);
+    // drm format thumbnails are kept in on pMonitor, as set by thumbnail_format but never deeper than the monitor's own
+    static uint32_t thumbnailFormatFor(PHLMONITOR pMonitor);
+    // drm format of a tile of size, full size ones are shown about as large as the monitor and keep its own
+    static uint32_t tileFormatFor(PHLMONITOR pMonitor, const Vector2D& size);
+    // renders pWorkspace offscreen as it would look on pMonitor, scaled into dest of target. Allocates scratch from the pool as needed.
+    static void renderWorkspaceThumbnail(PHLMONITOR pMonitor, PHLWORKSPACE pWorkspace, PHLWORKSPACE activeWorkspace, CFramebuffer& target, const CBox& dest,
+                                         SP<CFramebuffer>& scratch);
+    static void blitFramebuffer(CFramebuffer& from, const CBox& src, CFramebuffer& to, const CBox& dst);
+    // tile_source = surfaces, tiles are composed from the clients' own buffers instead of rendered offscreen
+    static bool surfaceTilesConfigured();
+    // rebuilds fb's mip chain after it was rendered to, tiles shown smaller than they were rendered are sampled from it
+    static void updateMipmaps(CFramebuffer& fb);
+    // looked up through the surface's role, popups and subsurfaces resolve to their parent
+    static SDamageOwner damageOwnerOf(SP<CWLSurfaceResource> pSurface);
 
     bool          blockOverviewRendering = false;
     bool          blockDamageReporting   = false;
@@ -39,30 +85,84 @@ class COverview {
     bool          m_isSwiping            = false;
 
     PHLMONITORREF pMonitor;
+    MONITORID     monitorID = -1;
 
-  private:
-    void       redrawID(int id, bool forcelowres = false);
-    void       redrawAll(bool forcelowres = false);
-    void       redrawAllValid(bool forcelowres = false);
-    void       onWorkspaceChange();
-    void       fullRender();
+    // nothing moving, nothing left to refresh and no frame scheduled by us
+    bool          idle = false;
 
-    int        SIDE_LENGTH = 3;
-    int        GAP_WIDTH   = 5;
-    CHyprColor BG_COLOR    = CHyprColor{0.1, 0.1, 0.1, 1.0};
-
-    bool       damageDirty = false;
+  private:
+    void        redrawID(int id, bool forcelowres = false);
+    Vector2D    thumbnailSize();
+    void        redrawForClose(int id);
+    bool        canBatchRender();
+    void        renderAtlasBatch(const std::vector<int>& ids);
+    void        refreshTiles(bool forcelowres = false);
+    void        invalidateAll();
+    bool        shouldRefreshLive(int id);
+    void        markWindowDamaged(PHLWINDOW pWindow);
+    int         tileForWorkspace(const PHLWORKSPACE& ws);
+    void        onWorkspaceChange();
+    void        fullRender(const CRegion& damage);
+    bool        isStatic();
+    void        damageTile(int id);
+    bool        tileVisible(int id);
+    CBox        atlasSlot(int id);
+    bool        cursorOnMonitor();
+    int         pageOf(int id);
+    // column and row of a tile within its page
+    Vector2D    gridPos(int id);
+    bool        tileResident(int id);
+    // rebuilds the layout from the current animation values
+    void        updateLayout();
+    // an unrendered swish tile the swipe is about to reveal
+    bool        inSwishPrefetch(int id);
+    // hit-tests the cursor against the grid, damaging the highlight if it moved to another tile
+    void        updateHover();
+    // applies the swipe input collected since the last frame
+    void        flushSwipe();
+    // one frame for any number of damage requests
+    void        requestFrame();
+    // applies the damage collected since the last frame
+    void        flushDamage();
+    // draws a tile's background layers and windows from their surface textures, no offscreen pass
+    void        renderSurfaceTile(int id, const CBox& texbox, const CRegion& damage);
+    bool        restoreFromCache(int id);
+
+    SGridConfig grid;
+    CHyprColor  BG_COLOR = CHyprColor{0.1, 0.1, 0.1, 1.0};
+
+    int         currentPage = 0;
+    double      pageScroll  = 0;
+
+    bool        surfaceTiles = false;
+
+    // damage requested between frames, applied by onPreRender
+    bool        fullDamagePending = false;
+    CRegion     tileDamagePending;
+    bool        frameRequested = false;
+    bool        layoutChanged  = false;
+    // refreshTiles left tiles for later
+    bool        workPending = false;
 
     struct SWorkspaceImage {
-        CFramebuffer fb;
-        int64_t      workspaceID = -1;
-        PHLWORKSPACE pWorkspace;
-        CBox         box;
+        SP<CFramebuffer> fb;
+        int64_t          workspaceID = -1;
+        PHLWORKSPACE     pWorkspace;
+        bool             dirty    = true;
+        bool             rendered = false;
+        bool             inAtlas  = false;
+        Time::steady_tp  lastRefresh;
     };
 
     Vector2D                     lastMousePosLocal = Vector2D{};
 
-    Vector2D                     totalSwipeDelta = Vector2D{0, 0};
+    Vector2D                     totalSwipeDelta   = Vector2D{0, 0};
+    Vector2D                     pendingSwipeDelta = Vector2D{0, 0};
+    Time::steady_tp              lastSwipeUpdate;
+    // zoom progress per second, positive towards closing
+    float                        swipeVelocity = 0;
+    // -1, 0 or 1 per axis, the way swish is panning
+    Vector2D                     swipeDirection = Vector2D{0, 0};
 
     int                          type = 0; // 0 = Expo, 1 = Swish
 
@@ -70,20 +170,32 @@ class COverview {
     int                          closeOnID = -1;
 
     std::vector<SWorkspaceImage> images;
+    SP<CFramebuffer>             scratchFB;
+    SP<CFramebuffer>             atlasFB;
 
     PHLWORKSPACE                 startedOn;
 
     PHLANIMVAR<Vector2D>         size;
     PHLANIMVAR<Vector2D>         pos;
     PHLANIMVAR<float>            scale;
-    int                          hoveredID = -1;
+    CGridLayout                  layout;
+    int                          hoveredID     = -1;
+    int                          refreshCursor = 0;
 
     bool                         closing = false;
 
+    Time::steady_tp              openedAt;
+    // wakes us when a rate limited tile is due
+    SP<CEventLoopTimer>          wakeTimer;
+    bool                         firstFrameShown = false;
+    // the previous frame while busy, frame intervals aren't measured across idle stretches
+    Time::steady_tp              lastFrameAt;
+
     CHyprSignalListener          mouseMoveHook;
     CHyprSignalListener          mouseButtonHook;
     CHyprSignalListener          touchMoveHook;
     CHyprSignalListener          touchDownHook;
+    CHyprSignalListener          mouseAxisHook;
 
     bool                         swipe             = false;
     bool                         swipeWasCommenced = false;
@@ -91,4 +203,14 @@ class COverview {
     friend class COverviewPassElement;
 };
 
-inline std::unique_ptr<COverview> g_pOverview;
+// at most one overview per monitor
+inline std::unordered_map<MONITORID, std::unique_ptr<COverview>> g_overviews;
+
+// the overview open on a monitor, if any
+inline COverview* overviewFor(MONITORID id) {
+    if (g_overviews.empty())
+        return nullptr;
+
+    const auto IT = g_overviews.find(id);
+    return IT == g_overviews.end() ? nullptr : IT->second.get();
+}